@@ -1,7 +1,12 @@
 #include<iostream>
+#include<iomanip>
 #include<type_traits>
 #include<limits>
 #include<algorithm>
+#include<vector>
+#include<cmath>
+
+#include<boost/optional.hpp>
 
 #include<CGAL/Exact_predicates_exact_constructions_kernel.h>
 
@@ -17,72 +22,222 @@ double floor_to_double(const K::FT& x) {
   return a;
 }
 
+// Relative error bound for a*b +- c*d evaluated in doubles when a, b, c, d are exact
+const double EPS = 4 * std::numeric_limits<double>::epsilon();
+const double INF = std::numeric_limits<double>::infinity();
+
+struct Box {
+  double xmin, ymin, xmax, ymax;
+};
+
+// Ray in double coordinates. Exact as long as all input coordinates are integers below 2^52
+struct Query {
+  double ox, oy, dx, dy;
+};
+
+// Bounding volume hierarchy over the bounding boxes of a static set of segments.
+// Nodes are only pruned with conservative double filters, the exact kernel decides every actual hit.
+// The query walks the tree front to back and shortens itself on every hit, so that usually only
+// a handful of exact intersections have to be constructed per ray.
+class RayShooter {
+public:
+  explicit RayShooter(const std::vector<Segment>& segments) : segments(segments), order(segments.size()) {
+    boxes.reserve(segments.size());
+    for(const Segment& s : segments) {
+      const CGAL::Bbox_2 b = s.bbox();
+      boxes.push_back({b.xmin(), b.ymin(), b.xmax(), b.ymax()});
+    }
+    for(int i = 0; i < (int) order.size(); ++i) order[i] = i;
+
+    nodes.reserve(2 * segments.size() / LEAF_SIZE + 1);
+    if(!segments.empty()) build(0, segments.size());
+  }
+
+  // Returns the closest intersection of the ray with any of the segments, if there is one
+  boost::optional<Point> first_hit(const Ray& ray) const {
+    const Query q = { CGAL::to_double(ray.source().x()), CGAL::to_double(ray.source().y()),
+                      CGAL::to_double(ray.direction().dx()), CGAL::to_double(ray.direction().dy()) };
+    const Point& o = ray.source();
+
+    bool found = false;
+    Segment curr_segment;
+    double t_max = INF;  // Upper bound on the projection of the current hit onto the ray direction
+
+    std::vector<int> stack;
+    if(!nodes.empty()) stack.push_back(0);
+
+    while(!stack.empty()) {
+      const Node& node = nodes[stack.back()]; stack.pop_back();
+      double entry;
+      if(!may_hit(node.box, q, t_max, entry)) continue;
+
+      if(node.left < 0) {
+        for(int i = node.begin; i < node.end; ++i) {
+          const Segment& segment = segments[order[i]];
+          if(!may_hit(boxes[order[i]], q, t_max, entry)) continue;
+
+          if(!found) {
+            if(!CGAL::do_intersect(ray, segment)) continue;
+            curr_segment = clip(o, ray, segment);
+            found = true;
+          } else {
+            if(!CGAL::do_intersect(curr_segment, segment)) continue;
+            curr_segment = clip(o, curr_segment, segment);
+          }
+          t_max = projection_upper_bound(q, curr_segment.target());
+        }
+      } else {
+        // Push the farther child first so that the closer one is visited first
+        double entry_left, entry_right;
+        const bool hit_left = may_hit(nodes[node.left].box, q, t_max, entry_left);
+        const bool hit_right = may_hit(nodes[node.right].box, q, t_max, entry_right);
+
+        if(entry_left <= entry_right) {
+          if(hit_right) stack.push_back(node.right);
+          if(hit_left) stack.push_back(node.left);
+        } else {
+          if(hit_left) stack.push_back(node.left);
+          if(hit_right) stack.push_back(node.right);
+        }
+      }
+    }
+
+    if(!found) return boost::none;
+    return curr_segment.target();
+  }
+
+  // Answers many rays against the same set of segments
+  std::vector<boost::optional<Point>> first_hits(const std::vector<Ray>& rays) const {
+    std::vector<boost::optional<Point>> hits; hits.reserve(rays.size());
+    for(const Ray& ray : rays) hits.push_back(first_hit(ray));
+    return hits;
+  }
+
+private:
+  static const int LEAF_SIZE = 4;
+
+  struct Node {
+    Box box;
+    int left, right;  // Children, -1 for leaves
+    int begin, end;   // Range in order
+  };
+
+  std::vector<Segment> segments;
+  std::vector<Box> boxes;
+  std::vector<int> order;
+  std::vector<Node> nodes;
+
+  // Builds the subtree over order[begin, end) by splitting at the median along the longer axis
+  int build(int begin, int end) {
+    Box box = boxes[order[begin]];
+    for(int i = begin + 1; i < end; ++i) {
+      const Box& b = boxes[order[i]];
+      box.xmin = std::min(box.xmin, b.xmin); box.ymin = std::min(box.ymin, b.ymin);
+      box.xmax = std::max(box.xmax, b.xmax); box.ymax = std::max(box.ymax, b.ymax);
+    }
+
+    const int idx = nodes.size();
+    nodes.push_back({box, -1, -1, begin, end});
+    if(end - begin <= LEAF_SIZE) return idx;
+
+    const bool split_x = box.xmax - box.xmin >= box.ymax - box.ymin;
+    const int mid = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end, [&](int a, int b) {
+      const Box& ba = boxes[a]; const Box& bb = boxes[b];
+      return split_x ? ba.xmin + ba.xmax < bb.xmin + bb.xmax : ba.ymin + ba.ymax < bb.ymin + bb.ymax;
+    });
+
+    const int left = build(begin, mid);
+    const int right = build(mid, end);
+    nodes[idx].left = left;
+    nodes[idx].right = right;
+    return idx;
+  }
+
+  // Conservative filter, returns false only if the ray certainly misses the box or the box certainly lies
+  // beyond t_max. entry is set to a lower bound of the projection of the box onto the ray direction
+  static bool may_hit(const Box& box, const Query& q, double t_max, double& entry) {
+    const double xs[2] = { box.xmin - q.ox, box.xmax - q.ox };
+    const double ys[2] = { box.ymin - q.oy, box.ymax - q.oy };
+
+    bool all_left = true, all_right = true;
+    double proj_min = INF, proj_max = -INF;
+    for(int i = 0; i < 2; ++i) {
+      for(int j = 0; j < 2; ++j) {
+        // Orientation of the corner relative to the supporting line of the ray
+        const double a = q.dx * ys[j], b = q.dy * xs[i];
+        const double det = a - b, det_err = EPS * (std::abs(a) + std::abs(b));
+        if(!(det > det_err)) all_left = false;
+        if(!(det < -det_err)) all_right = false;
+
+        // Projection of the corner onto the ray direction
+        const double c = q.dx * xs[i], d = q.dy * ys[j];
+        const double proj = c + d, proj_err = EPS * (std::abs(c) + std::abs(d));
+        proj_min = std::min(proj_min, proj - proj_err);
+        proj_max = std::max(proj_max, proj + proj_err);
+      }
+    }
+
+    entry = proj_min;
+    return !all_left && !all_right && proj_max >= 0 && proj_min <= t_max;
+  }
+
+  // Upper bound on the projection of p onto the ray direction, using the interval approximation of p
+  static double projection_upper_bound(const Query& q, const Point& p) {
+    const std::pair<double, double> x = CGAL::to_interval(p.x());
+    const std::pair<double, double> y = CGAL::to_interval(p.y());
+    const double px = (q.dx >= 0 ? x.second : x.first) - q.ox;
+    const double py = (q.dy >= 0 ? y.second : y.first) - q.oy;
+    const double c = q.dx * px, d = q.dy * py;
+    return c + d + 2 * EPS * (std::abs(c) + std::abs(d) + std::abs(q.dx * q.ox) + std::abs(q.dy * q.oy));
+  }
+
+  // Shortens the query (ray or segment) to a segment from o to its closest intersection with segment
+  template<typename Q>
+  static Segment clip(const Point& o, const Q& query, const Segment& segment) {
+    auto its = CGAL::intersection(query, segment);
+
+    if(const Point* its_p = boost::get<Point>(&*its)) {
+      return Segment(o, *its_p);
+    } else if (const Segment* its_s = boost::get<Segment>(&*its)) {
+      Point source = its_s->source();
+      Point target = its_s->target();
+
+      return Segment(o, CGAL::squared_distance(o, source) < CGAL::squared_distance(o, target) ? source : target);
+    } else {
+      throw std::runtime_error("Undefined intersection");
+    }
+  }
+};
+
 int main() {
   std::ios_base::sync_with_stdio(false);
-  
+  std::cout << std::setprecision(0) << std::fixed;
+
   while(true) {
     // ===== READ INPUT =====
     int n; std::cin >> n;
     if(!n) break;
-    
+
     long x, y, a, b; std::cin >> x >> y >> a >> b;
     Point o(x, y), d(a, b);
     Ray ray(o, d);
-    
+
     std::vector<Segment> segments(n);
     for(int i = 0; i < n; ++i) {
       long r, s, t, u; std::cin >> r >> s >> t >> u;
       segments[i] = Segment(Point(r, s), Point(t, u));
     }
-    std::random_shuffle(segments.begin(), segments.end());
-    
+
     // ===== FIND FIRST HIT =====
-    bool found = false;
-    Segment curr_segment;
-    
-    for(const Segment& segment : segments) {
-      if(!found) {
-        if(CGAL::do_intersect(ray, segment)) {
-          std::result_of<K::Intersect_2(Ray, Segment)>::type its = CGAL::intersection(ray, segment);
-          found = true;
-          
-          if(const Point* its_p = boost::get<Point>(&*its)) {
-            curr_segment = Segment(ray.source(), *its_p);
-          } else if (const Segment* its_s = boost::get<Segment>(&*its)) {
-            Point source = its_s->source();
-            Point target = its_s->target();
-            
-            curr_segment = Segment(ray.source(),
-                                   CGAL::squared_distance(o, source) < CGAL::squared_distance(o, target) ? source : target);
-          } else {
-            throw std::runtime_error("Undefined intersection");
-          }
-        }
-      } else {
-        if(CGAL::do_intersect(curr_segment, segment)) {
-          std::result_of<K::Intersect_2(Segment, Segment)>::type its = CGAL::intersection(curr_segment, segment);
-          
-          if(const Point* its_p = boost::get<Point>(&*its)) {
-            curr_segment = Segment(curr_segment.source(), *its_p);
-          } else if (const Segment* its_s = boost::get<Segment>(&*its)) {
-            Point source = its_s->source();
-            Point target = its_s->target();
-            
-            curr_segment = Segment(o,
-                                   CGAL::squared_distance(o, source) < CGAL::squared_distance(o, target) ? source : target);
-          } else {
-            throw std::runtime_error("Undefined intersection");
-          }
-        }
-      }
-    }
-    
+    const RayShooter shooter(segments);
+    const boost::optional<Point> hit = shooter.first_hits({ray})[0];
+
     // ===== OUTPUT =====
-    if(found) {
-      std::cout << std::setprecision(0) << std::fixed;
-      std::cout << floor_to_double(curr_segment.target().x()) << " " << floor_to_double(curr_segment.target().y()) << std::endl;
+    if(hit) {
+      std::cout << floor_to_double(hit->x()) << " " << floor_to_double(hit->y()) << std::endl;
     } else {
       std::cout << "no" << std::endl;
     }
   }
-}
\ No newline at end of file
+}
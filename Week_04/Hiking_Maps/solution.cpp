@@ -1,101 +1,151 @@
 #include <iostream>
 #include <vector>
 #include <limits>
+#include <cstdint>
+#include <algorithm>
 
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 
 typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
 typedef K::Point_2 Point;
 
-// Checks if a point is inside of a triangle, by checking if it is on the right side of every edge of the triangle
-// This assumes that the individual edges are oriented such that right is inside and left is outside
-bool contains(const std::vector<Point> &triangle, const Point &point) {
-  return (!CGAL::left_turn(triangle[0], triangle[1], point) &&
-          !CGAL::left_turn(triangle[2], triangle[3], point) &&
-          !CGAL::left_turn(triangle[4], triangle[5], point));
+// Edges of all triangles as line coefficients in SoA layout (one array per coefficient and edge).
+// A point p is not left of edge e of triangle t iff a[e][t] * p.x + b[e][t] * p.y + c[e][t] <= 0.
+// All values are exact in 64 bit integers, as the input coordinates are bounded by 2^24
+struct TriangleLines {
+  std::vector<long> a[3], b[3], c[3];
+
+  explicit TriangleLines(int n) {
+    for(int e = 0; e < 3; ++e) { a[e].resize(n); b[e].resize(n); c[e].resize(n); }
+  }
+
+  // Stores the line through (p, q), such that the right side of p -> q is the inside
+  void set(int t, int e, const Point &p, const Point &q) {
+    const long px = p.x(), py = p.y(), qx = q.x(), qy = q.y();
+    const long dx = qx - px, dy = qy - py;
+    a[e][t] = -dy;
+    b[e][t] = dx;
+    c[e][t] = dy * px - dx * py;
+  }
+};
+
+// Computes for every triangle a packed bitmap of the path points it contains (one row of words per triangle).
+// Every (triangle, point) pair is tested exactly once and the rows are independent of each other
+std::vector<uint64_t> compute_membership(const TriangleLines &lines, const std::vector<long> &xs, const std::vector<long> &ys,
+                                         int n, int words) {
+  const int m = xs.size();
+  std::vector<uint64_t> inside((long) n * words);
+
+  #ifdef _OPENMP
+  #pragma omp parallel for schedule(static)
+  #endif
+  for(int t = 0; t < n; ++t) {
+    const long a0 = lines.a[0][t], b0 = lines.b[0][t], c0 = lines.c[0][t];
+    const long a1 = lines.a[1][t], b1 = lines.b[1][t], c1 = lines.c[1][t];
+    const long a2 = lines.a[2][t], b2 = lines.b[2][t], c2 = lines.c[2][t];
+    uint64_t *row = &inside[(long) t * words];
+
+    for(int w = 0; w < words; ++w) {
+      const int begin = w * 64, end = std::min(m, begin + 64);
+      uint64_t word = 0;
+      for(int j = begin; j < end; ++j) {
+        const uint64_t in = (a0 * xs[j] + b0 * ys[j] + c0 <= 0) &
+                            (a1 * xs[j] + b1 * ys[j] + c1 <= 0) &
+                            (a2 * xs[j] + b2 * ys[j] + c2 <= 0);
+        word |= in << (j - begin);
+      }
+      row[w] = word;
+    }
+  }
+
+  return inside;
 }
 
 void solve() {
   // ===== READ INPUT =====
   int m, n; std::cin >> m >> n;
-  
+
   // Read hiking path
-  std::vector<Point> path; path.reserve(m);
+  std::vector<long> xs(m), ys(m);
   for(int i = 0; i < m; ++i) {
-    int x, y; std::cin >> x >> y;
-    path.emplace_back(x, y);
+    std::cin >> xs[i] >> ys[i];
   }
-  
+
   // Read map parts
-  std::vector<std::vector<Point>> triangles(n);
-  for(int i = 0; i < n; ++i) {
-    // Read all points
-    triangles[i].reserve(6);
-    for(int j = 0; j < 6; ++j) {
-      int x, y; std::cin >> x >> y;
-      triangles[i].emplace_back(x, y);
-    }
+  std::vector<Point> triangle_points; triangle_points.reserve(6 * n);
+  for(int i = 0; i < 6 * n; ++i) {
+    int x, y; std::cin >> x >> y;
+    triangle_points.emplace_back(x, y);
   }
-  
+
   // ===== SOLVE =====
   // Ensure correct orientation for all lines/point pairs (Right Side -> Inside, Left Side -> Outside)
+  TriangleLines lines(n);
   for(int triangle_idx = 0; triangle_idx < n; ++triangle_idx) {
-    // Check for line a and swap if orientation is wrong
-    if(!CGAL::right_turn(triangles[triangle_idx][0], triangles[triangle_idx][1], triangles[triangle_idx][2])) {
-      std::swap(triangles[triangle_idx][0], triangles[triangle_idx][1]);
-    } 
-    // Check for line b and swap if orientation is wrong
-    if(!CGAL::right_turn(triangles[triangle_idx][2], triangles[triangle_idx][3], triangles[triangle_idx][4])) {
-      std::swap(triangles[triangle_idx][2], triangles[triangle_idx][3]);
-    } 
-    // Check for line c and swap if orientation is wrong
-    if(!CGAL::right_turn(triangles[triangle_idx][4], triangles[triangle_idx][5], triangles[triangle_idx][0])) {
-      std::swap(triangles[triangle_idx][4], triangles[triangle_idx][5]);
-    } 
+    Point *triangle = &triangle_points[6 * triangle_idx];
+
+    for(int e = 0; e < 3; ++e) {
+      // Check line e against the first point of the next line and swap if orientation is wrong
+      if(!CGAL::right_turn(triangle[2 * e], triangle[2 * e + 1], triangle[(2 * e + 2) % 6])) {
+        std::swap(triangle[2 * e], triangle[2 * e + 1]);
+      }
+      lines.set(triangle_idx, e, triangle[2 * e], triangle[2 * e + 1]);
+    }
   }
-  
-  // Pre compute, which map part contains covers which part of the hiking path
+
+  // Pre compute, which map part contains which points of the hiking path
+  const int words = (m + 63) / 64;
+  const std::vector<uint64_t> inside = compute_membership(lines, xs, ys, n, words);
+
+  // A leg (path_idx, path_idx + 1) is covered iff both of its points are, so the legs are the AND of adjacent bits
   std::vector<std::vector<int>> covers(n);
   for(int triangle_idx = 0; triangle_idx < n; ++triangle_idx) {
-    for(int path_idx = 0; path_idx < m - 1; ++path_idx) {
-      // Check if the leg (path_idx, path_idx + 1) is covered by the triangle
-      if(contains(triangles[triangle_idx], path[path_idx]) && contains(triangles[triangle_idx], path[path_idx + 1])) {
+    const uint64_t *row = &inside[(long) triangle_idx * words];
+
+    for(int w = 0; w < words; ++w) {
+      const uint64_t next = w + 1 < words ? row[w + 1] : 0;
+      uint64_t legs = row[w] & ((row[w] >> 1) | (next << 63));
+
+      while(legs) {
+        const int path_idx = w * 64 + __builtin_ctzll(legs);
+        if(path_idx >= m - 1) break;
         covers[triangle_idx].push_back(path_idx);
+        legs &= legs - 1;
       }
     }
   }
-    
+
   // Sliding window over map parts to find smallest
   std::vector<int> times_covered(m - 1, 0);  // Stores for each leg of the path how often it is covered by the current window
   int n_uncovered = m - 1;                   // Number of legs that are currently not covered by the current window
   int left = 0;
   int min_size = std::numeric_limits<int>::max();
-  
+
   for(int right = 0; right < n; ++right) {
     // Add the triangle[right] to the current window
     for(const int &leg_idx : covers[right]) {
       times_covered[leg_idx]++;
-      
+
       // If the leg was previously not covered, decrease the n_uncovered counter
-      if(times_covered[leg_idx] == 1) { n_uncovered--; } 
+      if(times_covered[leg_idx] == 1) { n_uncovered--; }
     }
 
     // Move left pointer until the not the entire path is covered
     while(n_uncovered == 0) {
       min_size = std::min(min_size, right - left + 1);
-      
+
       // Remove the triangle[left] from the current window
       for(const int &leg_idx : covers[left]) {
         times_covered[leg_idx]--;
-        
+
         // If the leg was is no longer covered, increase the n_uncovered counter
-        if(times_covered[leg_idx] == 0) { n_uncovered++; } 
+        if(times_covered[leg_idx] == 0) { n_uncovered++; }
       }
-      
+
       left++;
     }
   }
-  
+
   // ===== OUTPUT =====
   std::cout << min_size << std::endl;
 }
@@ -103,7 +153,7 @@ void solve() {
 
 int main() {
   std::ios_base::sync_with_stdio(false);
-  
+
   int n_tests; std::cin >> n_tests;
   while(n_tests--) { solve(); }
-}
\ No newline at end of file
+}
@@ -1,35 +1,157 @@
 #include<iostream>
 #include<vector>
+#include<limits>
+#include<cmath>
+#include<algorithm>
+
+#include<immintrin.h>
 
 #include<CGAL/Exact_predicates_inexact_constructions_kernel.h>
 
 using K = CGAL::Exact_predicates_inexact_constructions_kernel;
 
+// Relative error bound for a*b - c*d evaluated in doubles when a, b, c, d are exact.
+// All differences below are exact because the input coordinates are integers below 2^51
+const double EPS = 4 * std::numeric_limits<double>::epsilon();
+const int BLOCK_SIZE = 1024;
+
+enum Classification { MISS, HIT, UNSURE };
+
+struct RayData {
+  double ox, oy, dx, dy;
+};
+
+// Segments of one block in SoA layout, so that four of them can be tested at once
+struct SegmentBlock {
+  std::vector<double> sx, sy, tx, ty;
+  SegmentBlock() : sx(BLOCK_SIZE), sy(BLOCK_SIZE), tx(BLOCK_SIZE), ty(BLOCK_SIZE) {}
+};
+
+// Sign of a*b - c*d if the floating point evaluation certifies it, 0 otherwise
+int certain_sign(double a, double b, double c, double d) {
+  const double p = a * b, q = c * d;
+  const double det = p - q, err = EPS * (std::abs(p) + std::abs(q));
+  return det > err ? 1 : (det < -err ? -1 : 0);
+}
+
+// Filters a single ray/segment pair with the orientation tests:
+//   o1, o2: side of s and t relative to the supporting line of the ray
+//   o3:     side of the ray origin relative to the supporting line of the segment
+//   c:      cross product of segment and ray direction (the lines meet in front of the origin iff o3 and c differ in sign)
+Classification classify(const RayData& ray, double sx, double sy, double tx, double ty) {
+  const int o1 = certain_sign(ray.dx, sy - ray.oy, ray.dy, sx - ray.ox);
+  const int o2 = certain_sign(ray.dx, ty - ray.oy, ray.dy, tx - ray.ox);
+  if(o1 != 0 && o1 == o2) return MISS;
+
+  const double ex = tx - sx, ey = ty - sy;
+  const int o3 = certain_sign(ex, ray.oy - sy, ey, ray.ox - sx);
+  const int c = certain_sign(ex, ray.dy, ey, ray.dx);
+  if(o3 != 0 && o3 == c) return MISS;
+
+  if(o1 != 0 && o2 == -o1 && o3 != 0 && c == -o3) return HIT;
+  return UNSURE;
+}
+
+// Vectorized version of certain_sign, sets pos/neg for the lanes where the sign is certainly positive/negative
+__attribute__((target("avx2")))
+inline void certain_sign_avx2(__m256d a, __m256d b, __m256d c, __m256d d, __m256d& pos, __m256d& neg) {
+  const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+  const __m256d p = _mm256_mul_pd(a, b), q = _mm256_mul_pd(c, d);
+  const __m256d det = _mm256_sub_pd(p, q);
+  const __m256d err = _mm256_mul_pd(_mm256_set1_pd(EPS), _mm256_add_pd(_mm256_and_pd(p, abs_mask), _mm256_and_pd(q, abs_mask)));
+  pos = _mm256_cmp_pd(det, err, _CMP_GT_OQ);
+  neg = _mm256_cmp_pd(det, _mm256_sub_pd(_mm256_setzero_pd(), err), _CMP_LT_OQ);
+}
+
+// Classifies the four segments starting at i. Returns the lanes that certainly hit in hit_lanes and the
+// lanes that need the exact predicate in unsure_lanes (as 4 bit masks)
+__attribute__((target("avx2")))
+void classify_avx2(const RayData& ray, const SegmentBlock& block, int i, int& hit_lanes, int& unsure_lanes) {
+  const __m256d ox = _mm256_set1_pd(ray.ox), oy = _mm256_set1_pd(ray.oy);
+  const __m256d dx = _mm256_set1_pd(ray.dx), dy = _mm256_set1_pd(ray.dy);
+  const __m256d sx = _mm256_loadu_pd(&block.sx[i]), sy = _mm256_loadu_pd(&block.sy[i]);
+  const __m256d tx = _mm256_loadu_pd(&block.tx[i]), ty = _mm256_loadu_pd(&block.ty[i]);
+
+  __m256d pos1, neg1, pos2, neg2, pos3, neg3, posc, negc;
+  certain_sign_avx2(dx, _mm256_sub_pd(sy, oy), dy, _mm256_sub_pd(sx, ox), pos1, neg1);
+  certain_sign_avx2(dx, _mm256_sub_pd(ty, oy), dy, _mm256_sub_pd(tx, ox), pos2, neg2);
+
+  const __m256d ex = _mm256_sub_pd(tx, sx), ey = _mm256_sub_pd(ty, sy);
+  certain_sign_avx2(ex, _mm256_sub_pd(oy, sy), ey, _mm256_sub_pd(ox, sx), pos3, neg3);
+  certain_sign_avx2(ex, dy, ey, dx, posc, negc);
+
+  const __m256d miss = _mm256_or_pd(_mm256_or_pd(_mm256_and_pd(pos1, pos2), _mm256_and_pd(neg1, neg2)),
+                                    _mm256_or_pd(_mm256_and_pd(pos3, posc), _mm256_and_pd(neg3, negc)));
+  const __m256d hit = _mm256_and_pd(_mm256_or_pd(_mm256_and_pd(pos1, neg2), _mm256_and_pd(neg1, pos2)),
+                                    _mm256_or_pd(_mm256_and_pd(pos3, negc), _mm256_and_pd(neg3, posc)));
+
+  hit_lanes = _mm256_movemask_pd(hit);
+  unsure_lanes = ~(_mm256_movemask_pd(miss) | hit_lanes) & 0xF;
+}
+
+// Checks if the ray hits any of the first count segments of the block.
+// Only the segments that the floating point filter can not decide go to the exact CGAL predicate
+bool hits_any(const K::Ray_2& ray, const RayData& ray_data, const SegmentBlock& block, int count, bool use_avx2) {
+  auto exact_hit = [&](int i) {
+    return CGAL::do_intersect(ray, K::Segment_2(K::Point_2(block.sx[i], block.sy[i]), K::Point_2(block.tx[i], block.ty[i])));
+  };
+
+  int i = 0;
+  if(use_avx2) {
+    for(; i + 4 <= count; i += 4) {
+      int hit_lanes, unsure_lanes;
+      classify_avx2(ray_data, block, i, hit_lanes, unsure_lanes);
+      if(hit_lanes) return true;
+
+      for(int lane = 0; lane < 4; ++lane) {
+        if((unsure_lanes >> lane & 1) && exact_hit(i + lane)) return true;
+      }
+    }
+  }
+
+  for(; i < count; ++i) {
+    const Classification c = classify(ray_data, block.sx[i], block.sy[i], block.tx[i], block.ty[i]);
+    if(c == HIT || (c == UNSURE && exact_hit(i))) return true;
+  }
+
+  return false;
+}
+
 int main() {
   std::ios_base::sync_with_stdio(false);
-  
+
+  const bool use_avx2 = __builtin_cpu_supports("avx2");
+  SegmentBlock block;
+
   while(true) {
     int n; std::cin >> n;
     if(!n) break;
-    
+
     long x, y, a, b; std::cin >> x >> y >> a >> b;
     K::Ray_2 ray(K::Point_2(x, y), K::Point_2(a, b));
+    const RayData ray_data = { (double) x, (double) y, (double) (a - x), (double) (b - y) };
 
+    // Read and test the segments block by block, until one of them is hit
     bool hit = false;
-
-    for(int j = 0; j < n; ++j) {
-      long r, s, t, u; std::cin >> r >> s >> t >> u;
-  
-      K::Segment_2 segment(K::Point_2(r, s), K::Point_2(t, u));
-      
-      if(CGAL::do_intersect(ray, segment)) {
-        for(; j < n - 1; ++j) std::cin >> r >> s >> t >> u;
-        hit = true;
-        break;
+    int n_read = 0;
+    while(n_read < n && !hit) {
+      const int count = std::min(BLOCK_SIZE, n - n_read);
+      for(int i = 0; i < count; ++i) {
+        long r, s, t, u; std::cin >> r >> s >> t >> u;
+        block.sx[i] = r; block.sy[i] = s; block.tx[i] = t; block.ty[i] = u;
       }
+      n_read += count;
+
+      hit = hits_any(ray, ray_data, block, count, use_avx2);
+    }
+
+    // Skip the remaining segments line by line without parsing them
+    if(n_read < n) {
+      std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+      for(; n_read < n; ++n_read) std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
     }
-    
+
     if (hit) std::cout << "yes" << std::endl;
     else std::cout << "no" << std::endl;
   }
-}
\ No newline at end of file
+}
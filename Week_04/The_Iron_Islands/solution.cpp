@@ -1,101 +1,141 @@
 #include <iostream>
 #include <vector>
-#include <unordered_map>
 #include <algorithm>
 
-// [Prefix Sum, Distance to 0, Waterway Index]
-typedef std::tuple<int, int, int> Path;
+// Dense map from number of men (< k) to the most islands that can be conquered with them on a single waterway.
+// Entries are only valid if their stamp matches the current generation, so it can be reset in O(1) between tests
+class ComplementTable {
+public:
+  void reset(int k) {
+    if((int) best.size() < k) {
+      best.resize(k);
+      stamp.resize(k, 0);
+    }
+    generation++;
+  }
+
+  // Returns the most islands for exactly men men, or -1 if there is no such path
+  int get(int men) const {
+    return stamp[men] == generation ? best[men] : -1;
+  }
+
+  void update(int men, int num_islands) {
+    if(stamp[men] != generation) {
+      stamp[men] = generation;
+      best[men] = num_islands;
+    } else {
+      best[men] = std::max(best[men], num_islands);
+    }
+  }
+
+private:
+  std::vector<int> best;
+  std::vector<int> stamp;
+  int generation = 0;
+};
 
-void solve() {
+void solve(ComplementTable &table) {
   // ===== READ INPUT =====
   int n, k, w; std::cin >> n >> k >> w;
-  
+
   std::vector<int> required_men(n);
   for(int i = 0; i < n; ++i) { std::cin >> required_men[i]; }
-  
-  std::vector<std::vector<int>> waterways(w);
+
+  // All waterways in one flat array, waterway i is costs[offsets[i], offsets[i + 1])
+  std::vector<int> costs; costs.reserve(n + w);
+  std::vector<int> offsets(w + 1, 0);
   for(int i = 0; i < w; ++i) {
     int l; std::cin >> l;
-    waterways[i] = std::vector<int>(l);
 
     for(int j = 0; j < l; ++j) {
       int r; std::cin >> r;
-      waterways[i][j] = required_men[r];
+      costs.push_back(required_men[r]);
     }
+    offsets[i + 1] = costs.size();
   }
-  
+
   const int CENTER_COST = required_men[0];
-  
+
   // ===== SOLVE =====
   int max_size = 0;
-  
-  // Search for maximum size on each waterway individually
+
+  // Search for maximum size on each waterway individually. The waterways are independent, so they can be scanned in parallel
+  #ifdef _OPENMP
+  #pragma omp parallel for schedule(dynamic, 64) reduction(max: max_size)
+  #endif
   for(int i = 0; i < w; ++i) {
-    int l = waterways[i].size();
-    
+    const int *waterway = &costs[offsets[i]];
+    const int l = offsets[i + 1] - offsets[i];
+
     // Perform Sliding Window over waterway i
     int sum, left; sum = left = 0;
     for(int right = 0; right < l; ++right) {
-      sum += waterways[i][right];
-      
+      sum += waterway[right];
+
       while(sum > k) {
-        sum -= waterways[i][left];
+        sum -= waterway[left];
         left++;
       }
-      
+
       if(sum == k) {
         max_size = std::max(max_size, right - left + 1);
       }
     }
   }
-  
-  // Search for maximum size for 2 waterways
-  std::unordered_map<int, int> men_to_max_num_islands; // num_men -> most islands
-  std::vector<int> prefix_sums; // stores the 
+
+  // Calculate Prefix Sums (without the center) for all waterways in place of the costs.
+  // Capturing all visited islands on a waterway would require at least all k men, so it is not possible to be used in a combination of 2 waterways.
+  // Therefore only the prefixes [offsets[i] + 1, offsets[i] + num_prefixes[i]) are valid
+  std::vector<int> num_prefixes(w);
+  std::vector<int> &prefix_sums = costs;
+
+  #ifdef _OPENMP
+  #pragma omp parallel for schedule(dynamic, 64)
+  #endif
   for(int w_idx = 0; w_idx < w; ++w_idx) {
-    // Calculate Prefix Sums for the current waterway i
-    prefix_sums = std::vector<int>(1, 0);
-    
-    const int l = waterways[w_idx].size();
-    int sum = 0;
-    for(int i = 1; i < l; ++i) {
-      sum += waterways[w_idx][i];
-      if(sum >= k) { break; } // Capturing all visited islands on the current waterway would require at least all k men, so it is not possible to be used in a combination of 2 waterways
-      prefix_sums.push_back(sum);
+    int *prefix = &prefix_sums[offsets[w_idx]];
+    const int l = offsets[w_idx + 1] - offsets[w_idx];
+
+    prefix[0] = 0;
+    int i = 1;
+    for(; i < l; ++i) {
+      prefix[i] = prefix[i - 1] + prefix[i];
+      if(prefix[i] >= k) { break; }
     }
-    
-    const int l_sums = prefix_sums.size();
-    
-    // Check for each island j along the current waterway if the complement (k - [sums[j]) has already been seen before, if so this would form a valid window
-    for(int i = 1; i < l_sums; ++i) {
-      int complement = k - prefix_sums[i] - CENTER_COST;
-
-      if(men_to_max_num_islands.find(complement) != men_to_max_num_islands.end()) {
+    num_prefixes[w_idx] = i;
+  }
+
+  // Search for maximum size for 2 waterways
+  table.reset(k);
+  for(int w_idx = 0; w_idx < w; ++w_idx) {
+    const int *prefix = &prefix_sums[offsets[w_idx]];
+
+    // Check for each island i along the current waterway if the complement (k - sums[i]) has already been seen before, if so this would form a valid window
+    for(int i = 1; i < num_prefixes[w_idx]; ++i) {
+      const int complement = k - prefix[i] - CENTER_COST;
+      if(complement < 0) { break; }
+
+      const int num_islands = table.get(complement);
+      if(num_islands != -1) {
         // We have previously seen a waterway along which the remaining men could be used
-        max_size = std::max(max_size, i + men_to_max_num_islands[complement] + 1); // + 1 to account for the center
+        max_size = std::max(max_size, i + num_islands + 1); // + 1 to account for the center
       }
     }
-    
-    // Add the results from this waterway to the Hash Map
-    for(int i = 1; i < l_sums; ++i) {
-      // Check if there already exists an entry for the number men
-      if(men_to_max_num_islands.find(prefix_sums[i]) == men_to_max_num_islands.end()) {
-        // We have not encountered this amount of (remaining) men so create a new entry
-        men_to_max_num_islands[prefix_sums[i]] = i;
-      } else {
-        // We have previously encountered this amount of (remaining) men so only update if we can now capture more islands
-        men_to_max_num_islands[prefix_sums[i]] = std::max(men_to_max_num_islands[prefix_sums[i]], i);
-      }
+
+    // Only add the results from this waterway afterwards, so it is not combined with itself
+    for(int i = 1; i < num_prefixes[w_idx]; ++i) {
+      table.update(prefix[i], i);
     }
   }
-  
+
   // ===== OUTPUT =====
   std::cout << max_size << std::endl;
 }
 
 int main() {
   std::ios_base::sync_with_stdio(false);
-  
+
+  ComplementTable table;
   int n_tests; std::cin >> n_tests;
-  while(n_tests--) { solve(); }
-}
\ No newline at end of file
+  while(n_tests--) { solve(table); }
+}
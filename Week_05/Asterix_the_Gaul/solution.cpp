@@ -1,78 +1,121 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
-#include <array>
 #include <limits>
 
-using vi = std::vector<int>;
-using vpii = std::vector<std::pair<int, int>>;
+// A move covers distance in time
+struct Move {
+  int64_t distance, time;
+};
+
+// Remaining (time, distance) after taking a subset of moves
+using Entry = std::pair<int64_t, int64_t>;
+// For every number of moves taken the Pareto optimal entries, sorted by increasing time (and therefore distance)
+using Table = std::vector<std::vector<Entry>>;
 
-vpii moves;
-vi potions;
-std::array<std::vector<std::pair<int64_t, int64_t>>, 16> first_half, second_half;
-std::array<int64_t, 31> best_without_potion;
+// Removes all entries of a row that are dominated by an entry with at least as much remaining time and less remaining distance.
+// Single pass from the back, compacting the kept entries towards the end of the row
+void remove_suboptimal(std::vector<Entry> &row) {
+  if (row.size() <= 1) return;
+  std::sort(row.begin(), row.end(), [](const Entry &a, const Entry &b) {
+    return a.first < b.first || (a.first == b.first && a.second > b.second);
+  });
 
-void dfs_fill(int move, int moves_used, int64_t distance, int64_t time, int max_move, std::array<std::vector<std::pair<int64_t, int64_t>>, 16> &arr) {
-  if (time <= 0) return;
-  if (move >= max_move) {
-    arr[moves_used].emplace_back(time, distance);
-    return;
+  int keep = row.size();
+  int64_t min_distance = std::numeric_limits<int64_t>::max();
+  for (int i = row.size() - 1; i >= 0; --i) {
+    if (row[i].second < min_distance) {
+      min_distance = row[i].second;
+      row[--keep] = row[i];
+    }
   }
-  dfs_fill(move + 1, moves_used, distance, time, max_move, arr);
-  dfs_fill(move + 1, moves_used + 1, distance - moves[move].first, time - moves[move].second, max_move, arr);
+  row.erase(row.begin(), row.begin() + keep);
 }
 
-void sort_and_remove_suboptimal(std::array<std::vector<std::pair<int64_t, int64_t>>, 16> &arr) {
-  for (auto &row : arr) {
-    if (row.size() <= 1) continue;
-    std::sort(row.begin(), row.end(), [](const auto &a, const auto &b) {
-      return a.first < b.first || (a.first == b.first && a.second > b.second);
-    });
-    int64_t min_distance = row.back().second;
-    for (int i = row.size() - 2; i >= 0; --i) {
-      if (row[i].second >= min_distance) row.erase(row.begin() + i);
-      else min_distance = row[i].second;
+// Lists all subsets of moves[begin, end) that leave some time, grouped by their number of moves.
+// The subsets are enumerated iteratively in Gray code order, so every step only adds or removes a single move
+Table list_subsets(const std::vector<Move> &moves, int begin, int end, int64_t distance, int64_t time) {
+  const int n = end - begin;
+  Table table(n + 1);
+
+  uint32_t mask = 0;
+  int moves_used = 0;
+  if (time > 0) table[0].emplace_back(time, distance);
+
+  for (uint32_t step = 1; step < (1u << n); ++step) {
+    const int bit = __builtin_ctz(step);
+    const Move &move = moves[begin + bit];
+    mask ^= 1u << bit;
+
+    if (mask >> bit & 1) {
+      distance -= move.distance; time -= move.time; moves_used++;
+    } else {
+      distance += move.distance; time += move.time; moves_used--;
     }
+    if (time > 0) table[moves_used].emplace_back(time, distance);
   }
+
+  for (auto &row : table) remove_suboptimal(row);
+  return table;
 }
 
-void clear() {
-  for (auto &v : first_half) v.clear();
-  for (auto &v : second_half) v.clear();
+// Split and list over all moves. Returns for every number of moves the smallest remaining distance that can be reached in time
+std::vector<int64_t> best_remaining_distances(const std::vector<Move> &moves, int64_t distance, int64_t time) {
+  const int n = moves.size();
+  const int split = (n + 1) / 2;
+
+  // The two halves are independent, so they can be listed in parallel
+  Table first_half, second_half;
+  #ifdef _OPENMP
+  #pragma omp parallel sections
+  #endif
+  {
+    #ifdef _OPENMP
+    #pragma omp section
+    #endif
+    first_half = list_subsets(moves, 0, split, distance, time);
+    #ifdef _OPENMP
+    #pragma omp section
+    #endif
+    second_half = list_subsets(moves, split, n, distance, time);
+  }
+
+  std::vector<int64_t> best(n + 1, std::numeric_limits<int64_t>::max());
+  for (int i = 0; i < (int) first_half.size(); i++) {
+    const auto &first_row = first_half[i];
+
+    for (int j = 0; j < (int) second_half.size(); j++) {
+      const auto &second_row = second_half[j];
+
+      // Going through the first row by decreasing time, the time needed from the second row only increases.
+      // The cheapest partner is the first one with enough time, so the pointer into the second row only moves forward
+      size_t partner = 0;
+      for (int k = first_row.size() - 1; k >= 0; --k) {
+        const Entry &elem = first_row[k];
+        while (partner < second_row.size() && second_row[partner].first <= time - elem.first) partner++;
+        if (partner == second_row.size()) break;
+
+        best[i + j] = std::min(best[i + j], elem.second + second_row[partner].second - distance);
+      }
+    }
+  }
+
+  return best;
 }
 
 void solve() {
-  clear();
   int nr_moves, nr_potions;
   int64_t distance, time;
   std::cin >> nr_moves >> nr_potions >> distance >> time;
 
-  moves.resize(nr_moves);
-  for (auto &m : moves) std::cin >> m.first >> m.second;
+  std::vector<Move> moves(nr_moves);
+  for (auto &m : moves) std::cin >> m.distance >> m.time;
 
-  potions.resize(nr_potions);
+  std::vector<int> potions(nr_potions);
   for (auto &p : potions) std::cin >> p;
   std::sort(potions.begin(), potions.end());
 
-  best_without_potion.fill(std::numeric_limits<int64_t>::max());
-  dfs_fill(0, 0, distance, time, (nr_moves + 1) / 2, first_half);
-  dfs_fill((nr_moves + 1) / 2, 0, distance, time, nr_moves, second_half);
-
-  sort_and_remove_suboptimal(first_half);
-  sort_and_remove_suboptimal(second_half);
-
-  for (int i = 0; i <= (nr_moves + 1) / 2; i++) {
-    for (const auto &elem : first_half[i]) {
-      for (int j = 0; j <= nr_moves / 2; j++) {
-        const auto &row = second_half[j];
-        auto it = std::upper_bound(row.begin(), row.end(), time - elem.first, [](const auto &value, const auto &elem) {
-          return value < elem.first;
-        });
-        if (it == row.end()) break;
-        best_without_potion[i + j] = std::min(best_without_potion[i + j], elem.second + it->second - distance);
-      }
-    }
-  }
+  const std::vector<int64_t> best_without_potion = best_remaining_distances(moves, distance, time);
 
   int64_t best = std::numeric_limits<int64_t>::max();
   for (int i = 1; i <= nr_moves; i++) {
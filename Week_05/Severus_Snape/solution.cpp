@@ -4,10 +4,9 @@
 #include <algorithm>
 
 typedef std::vector<long> VL;
-typedef std::vector<VL>   VVL;
-typedef std::vector<VVL>  VVVL;
 
-const long neg_inf = std::numeric_limits<long>::min();
+// Marks unreachable states. Far enough from the minimum, that adding powers to it can not overflow
+const long neg_inf = std::numeric_limits<long>::min() / 2;
 
 struct PotionA {
   int power;
@@ -38,46 +37,47 @@ void solve() {
   
   // ===== SOLVE =====
   // === DETERMINE MAXIMUM POSSIBLE POWER FOR HAPPINESS H (ONLY A POTIONS) ===
-  // dp[i][j][h] = p: Only taking j of the first i (type A) potions, 
+  // dp[j][h] = p: Only taking j of the first i (type A) potions, 
   // how much magical power p can be reached while reaching at least happiness h?
-  VVVL dp(n + 1, VVL(n + 1, VL(H + 1, neg_inf)));
+  // Only layer i - 1 is needed to compute layer i, so a single (n + 1) x (H + 1) layer is updated in place for every potion.
+  // It is stored flat with row j at dp[j * (H + 1)]
+  const int row = H + 1;
+  VL dp((n + 1) * row, neg_inf);
   
-  // Fill all values dp[i][1][h], where only one potion is taken
-  // In these cases, simply take the potion among the first i potions,
-  // that yields the highest magical power p while having at least happiness h
-  for(int h = 0; h <= H; ++h) {    // Iterate over minimum required happiness h
-    for(int i = 1; i <= n; ++i) {  // Iterate over available potions (first i potions)
-      // Not take the new potion [i-1]
-      dp[i][1][h] = dp[i-1][1][h];
-      
-      // Check if the new potion [i-1] would provide more magical power
-      if(a_potions[i-1].happiness >= h &&   // Check if the new potion [i-1] provides enough happiness
-        dp[i][1][h] < a_potions[i-1].power  // Check if taking the new potion would provide more power than any previous potion
-      ) {
-        // Take the new potion [i-1]
-        dp[i][1][h] = a_potions[i-1].power;
-      }
-    }
-  }
+  // Taking no potion yields no power and no happiness
+  dp[0] = 0;
   
-  // Recursively fill the remaining dp entries
   // For each new potion [i-1] we can either 
-  // Not take it -> Power stays the same dp[i][j][h] = dp[i-1][j][h]
-  // Take it     -> Power becomes        dp[i-1][j-1][h - a_potions[i-1].happiness] + a_potions[i-1].power
+  // Not take it -> Power stays the same dp[j][h] (value of the previous layer)
+  // Take it     -> Power becomes        dp[j-1][h - a_potions[i-1].happiness] + a_potions[i-1].power
   //                This is because we take the maximum power we were able to get with j - 1 potions + the power of the potion itself
-  for(int j = 2; j <= n; ++j) {
-    for(int h = 0; h <= H; ++h) {
-      for(int i = j; i <= n; ++i) { // Start at i = j, as taking j potions among the first i < j would not be possible (invalid)
-        int happiness_before = std::max(0, h - a_potions[i-1].happiness);
-        dp[i][j][h] = std::max(
-            dp[i-1][j][h],                                        // Power when not taking the new potion [i-1]
-            dp[i-1][j-1][happiness_before] + a_potions[i-1].power // Power when     taking the new potion [i-1]
-          );
+  // Iterating j in reverse ensures that dp[j-1] still holds the values of the previous layer, i.e. every potion is taken at most once
+  for(int i = 1; i <= n; ++i) {
+    const long power = a_potions[i-1].power;
+    const int happiness = std::min<long>(a_potions[i-1].happiness, H);
+    
+    for(int j = i; j >= 1; --j) { // Taking j > i potions among the first i would not be possible (invalid)
+      long *curr = &dp[j * row];
+      const long *prev = &dp[(j - 1) * row];
+      
+      // For h <= happiness the new potion alone provides enough happiness, so we only need happiness 0 from the others
+      const long take_alone = prev[0] + power;
+      for(int h = 0; h <= happiness; ++h) {
+        curr[h] = std::max(curr[h], take_alone);
+      }
+      
+      // Otherwise, we need happiness h - happiness from the other potions (contiguous, so this loop vectorizes)
+      for(int h = happiness + 1; h <= H; ++h) {
+        curr[h] = std::max(curr[h], prev[h - happiness] + power);
       }
     }
-    
   }
   
+  // Maximum power with exactly j potions and happiness H. Taking one more potion never decreases power or happiness, 
+  // so this is monotone in j (once valid)
+  VL max_power(n + 1);
+  for(int j = 0; j <= n; ++j) { max_power[j] = dp[j * row + H]; }
+  
   // === GREEDILY DETERMINE THE NUMBER OF B POTIONS ===
   // Sort B Potions according to their wit (descendingly)
   std::sort(b_potions.begin(), b_potions.end(), [](const PotionB &a, const PotionB &b){
@@ -92,16 +92,16 @@ void solve() {
     
     // Check if enough wit is reached
     if(curr_wit >= W) {
-      // Look for the smallest amount of A potions that provides enough power
-      for(int num_potions_a = 1; num_potions_a <= n; num_potions_a++) {
-        // Check if taking num_potions_a A potions, has a too large wit penalty, causing the wit to no longer be above the threshold
-        if(curr_wit - num_potions_a * a < W) { break; }
-        
-        // Check if taking num_potions_a potions is enough to reach the power threshold P while also meeting the happiness threshold H
-        if(dp[n][num_potions_a][H] >= P + power_penalty) {
-          std::cout << num_potions_a + num_potions_b + 1 << std::endl;
-          return;
-        }
+      // Look for the smallest amount of A potions that provides enough power to reach the power threshold P while also meeting the happiness threshold H
+      const auto it = std::lower_bound(max_power.begin() + 1, max_power.end(), P + power_penalty);
+      if(it == max_power.end()) { continue; }
+      const int num_potions_a = it - max_power.begin();
+      
+      // Check if taking num_potions_a A potions, has a too large wit penalty, causing the wit to no longer be above the threshold.
+      // Taking more A potions would only make this worse
+      if(curr_wit - num_potions_a * a >= W) {
+        std::cout << num_potions_a + num_potions_b + 1 << std::endl;
+        return;
       }
     }
   }
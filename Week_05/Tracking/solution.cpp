@@ -1,73 +1,140 @@
 #include<iostream>
 #include<vector>
+#include<array>
 #include<limits>
-#include<cmath>
+#include<tuple>
+#include<cstdint>
 
-#include<boost/graph/adjacency_list.hpp>
-#include<boost/graph/dijkstra_shortest_paths.hpp>
+// Monotone priority queue for Dijkstra (radix heap). Keys are bucketed by the highest bit in which they differ
+// from the last extracted key, so push is O(1) and pop is amortized O(log C)
+class RadixHeap {
+public:
+  bool empty() const { return size == 0; }
 
-using EdgeWeight = boost::property<boost::edge_weight_t, int>;
-using Graph = boost::adjacency_list<boost::vecS, 
-                                    boost::vecS,
-                                    boost::undirectedS,
-                                    boost::no_property,
-                                    EdgeWeight>;
-using VertexDescriptor = boost::graph_traits<Graph>::vertex_descriptor;
-using EdgeDescriptor = boost::graph_traits<Graph>::edge_descriptor;
+  void push(uint64_t key, int value) {
+    buckets[bucket_of(key)].emplace_back(key, value);
+    size++;
+  }
+
+  std::pair<uint64_t, int> pop() {
+    if(buckets[0].empty()) {
+      // Redistribute the first non-empty bucket around its minimum
+      int i = 1;
+      while(buckets[i].empty()) ++i;
+
+      last = buckets[i][0].first;
+      for(const auto &entry : buckets[i]) last = std::min(last, entry.first);
+      for(const auto &entry : buckets[i]) buckets[bucket_of(entry.first)].push_back(entry);
+      buckets[i].clear();
+    }
+
+    const std::pair<uint64_t, int> top = buckets[0].back();
+    buckets[0].pop_back();
+    size--;
+    return top;
+  }
+
+  void clear() {
+    for(auto &bucket : buckets) bucket.clear();
+    last = 0;
+    size = 0;
+  }
+
+private:
+  std::array<std::vector<std::pair<uint64_t, int>>, 65> buckets;
+  uint64_t last = 0;
+  size_t size = 0;
+
+  int bucket_of(uint64_t key) const {
+    return key == last ? 0 : 64 - __builtin_clzll(key ^ last);
+  }
+};
+
+// Shortest paths that use at least k river roads, without building the k + 1 layers explicitly.
+// A state (city, layer) is stored as layer * n + city, where layer is the number of river roads used so far (capped at k).
+// Regular roads stay in the same layer, river roads move to the next one. Using a river road without changing layer
+// never helps, as a higher layer can reach everything a lower one can
+class TrackingGraph {
+public:
+  // edges: (a, b, travel time, is river)
+  TrackingGraph(int n, const std::vector<std::tuple<int, int, int, bool>> &edges) : n(n), offsets(n + 1, 0) {
+    // Build the base graph once in CSR format (each road in both directions)
+    for(const auto &edge : edges) {
+      offsets[std::get<0>(edge) + 1]++;
+      offsets[std::get<1>(edge) + 1]++;
+    }
+    for(int u = 0; u < n; ++u) offsets[u + 1] += offsets[u];
+
+    targets.resize(offsets[n]); weights.resize(offsets[n]); rivers.resize(offsets[n]);
+    std::vector<int> pos(offsets.begin(), offsets.end() - 1);
+    for(const auto &edge : edges) {
+      int a, b, w; bool river; std::tie(a, b, w, river) = edge;
+      targets[pos[a]] = b; weights[pos[a]] = w; rivers[pos[a]++] = river;
+      targets[pos[b]] = a; weights[pos[b]] = w; rivers[pos[b]++] = river;
+    }
+  }
+
+  // Minimum travel time from x to y using at least k river roads (-1 if impossible).
+  // Can be called for many queries, only the distance array is reused between them
+  long query(int x, int y, int k) {
+    const int n_states = n * (k + 1);
+    if((int) dist.size() < n_states) dist.resize(n_states);
+    std::fill(dist.begin(), dist.begin() + n_states, std::numeric_limits<uint64_t>::max());
+    heap.clear();
+
+    const int target = k * n + y;
+    dist[x] = 0;
+    heap.push(0, x);
+
+    while(!heap.empty()) {
+      uint64_t d; int state; std::tie(d, state) = heap.pop();
+      if(d != dist[state]) continue;  // Outdated entry
+      if(state == target) return d;
+
+      const int layer = state / n, u = state - layer * n;
+      const int river_layer = std::min(layer + 1, k);
+
+      for(int e = offsets[u]; e < offsets[u + 1]; ++e) {
+        const int next = (rivers[e] ? river_layer : layer) * n + targets[e];
+        const uint64_t next_d = d + weights[e];
+
+        if(next_d < dist[next]) {
+          dist[next] = next_d;
+          heap.push(next_d, next);
+        }
+      }
+    }
+
+    return -1;
+  }
+
+private:
+  int n;
+  std::vector<int> offsets, targets, weights;
+  std::vector<char> rivers;
+  std::vector<uint64_t> dist;
+  RadixHeap heap;
+};
 
 
 int main() {
   std::ios_base::sync_with_stdio(false);
-  
+
   int n_tests; std::cin >> n_tests;
   while(n_tests--) {
     // ===== READ INPUT =====
     int n, m, k, x, y; std::cin >> n >> m >> k >> x >> y;
-    
-    std::vector<std::tuple<int, int, int>> edges;
-    std::vector<std::tuple<int, int, int>> river_edges;
-    
+
+    std::vector<std::tuple<int, int, int, bool>> edges; edges.reserve(m);
     for(int i = 0; i < m; i++) {
       int a, b, c, d; std::cin >> a >> b >> c >> d;
-      if(d) { river_edges.emplace_back(a, b, c); }
-      else { edges.emplace_back(a, b, c); }
+      edges.emplace_back(a, b, c, d);
     }
 
     // ===== FIND SHORTEST PATH =====
-    // Construct multi-layered Graph
-    Graph g(n * (k + 1));
-    
-    // Add regular edges
-    for(const std::tuple<int, int, int> edge : edges) {
-      int s = std::get<0>(edge);
-      int t = std::get<1>(edge);
-      int w = std::get<2>(edge);
-      
-      // Add edge in all layers of the graph
-      for(int i = 0; i < k + 1; ++i) {
-        boost::add_edge(i * n + s, i * n + t, EdgeWeight(w), g);
-      }
-    }
-    
-    // Add river edges
-    for(const std::tuple<int, int, int> edge : river_edges) {
-      int s = std::get<0>(edge);
-      int t = std::get<1>(edge);
-      int w = std::get<2>(edge);
-      
-      // Add edge in all layers of the graph
-      for(int i = 0; i < k; ++i) {
-        boost::add_edge(s +  i      * n, t +  i      * n, EdgeWeight(w), g);
-        boost::add_edge(s + (i + 1) * n, t +  i      * n, EdgeWeight(w), g);
-        boost::add_edge(s +  i      * n, t + (i + 1) * n, EdgeWeight(w), g);
-        boost::add_edge(s + (i + 1) * n, t + (i + 1) * n, EdgeWeight(w), g);
-      }
-    }
-    
-    std::vector<int> dist_map(n * (k + 1));
-    boost::dijkstra_shortest_paths(g, x, boost::distance_map(boost::make_iterator_property_map(dist_map.begin(), boost::get(boost::vertex_index, g))));
-    
+    TrackingGraph graph(n, edges);
+
     // ===== OUTPUT =====
-    std::cout << dist_map[k * n + y] << std::endl;
+    std::cout << graph.query(x, y, k) << std::endl;
   }
-}
\ No newline at end of file
+}
@@ -1,82 +1,158 @@
 #include<iostream>
+#include<vector>
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/push_relabel_max_flow.hpp>
-
-using traits = boost::adjacency_list_traits<boost::vecS, boost::vecS, boost::directedS>;
-using graph = boost::adjacency_list<boost::vecS, 
-                                    boost::vecS, 
-                                    boost::directedS, 
-                                    boost::no_property,
-                                    boost::property<boost::edge_capacity_t, long,
-                                                    boost::property<boost::edge_residual_capacity_t, long,
-                                                                    boost::property<boost::edge_reverse_t, traits::edge_descriptor>>>>;
-using vertex_desc = traits::vertex_descriptor;
-using edge_desc = traits::edge_descriptor;
-
-
-class edge_adder {
-  graph &G;
-  
-  public:
-    explicit edge_adder(graph &G) : G(G) {}
-    
-    void add_edge(int from, int to, long capacity) {
-      auto c_map = boost::get(boost::edge_capacity, G);
-      auto r_map = boost::get(boost::edge_reverse, G);
-      const auto e = boost::add_edge(from, to, G).first;
-      const auto rev_e = boost::add_edge(to, from, G).first;
-      c_map[e] = capacity;
-      c_map[rev_e] = 0; // reverse edge has no capacity!
-      r_map[e] = rev_e;
-      r_map[rev_e] = e;
+// Incremental max flow on the network  source -> games -> players -> sink  (games have capacity 1, players their score).
+// Every game has only one unit of flow, so the flow is just the player each game currently gives its point to.
+// The flow is maximum iff no unassigned game has an augmenting path to a player with a free point. A new game is the
+// only new way out of the source, so one search from it suffices. Any other change (a result or a score) can open
+// paths from any unassigned game, so afterwards every unassigned game is searched again
+class ScoreFlow {
+public:
+  explicit ScoreFlow(int n) : score(n, 0), load(n, 0), incident(n), visit(n, 0), dead(n, -1), via(n) {}
+
+  // Adds a game between a and b with result c (1: a won, 2: b won, 0: unknown). Returns the index of the game
+  int add_game(int a, int b, int c) {
+    const int g = player_a.size();
+    player_a.push_back(a); player_b.push_back(b); result.push_back(c);
+    owner.push_back(-1); free_slot.push_back(free_games.size()); free_games.push_back(g);
+    incident[a].push_back(g);
+    if(b != a) incident[b].push_back(g);
+
+    place(g);
+    return g;
+  }
+
+  // Changes the result of game g
+  void set_result(int g, int c) {
+    result[g] = c;
+    if(owner[g] != -1 && !allowed(g, owner[g])) release(g);
+    augment();
+  }
+
+  // Changes the final score of player p
+  void set_score(int p, int s) {
+    score_sum += s - score[p];
+    score[p] = s;
+    for(size_t i = 0; load[p] > s; ++i) {
+      if(owner[incident[p][i]] == p) release(incident[p][i]);
+    }
+    augment();
+  }
+
+  // The scoreboard is possible if all points are given away and every player gets exactly the score
+  bool feasible() const {
+    return free_games.empty() && score_sum == (long) player_a.size();
+  }
+
+  // Number of games that currently give their point to a player (the value of the flow)
+  int assigned() const {
+    return player_a.size() - free_games.size();
+  }
+
+private:
+  std::vector<int> player_a, player_b, result;
+  std::vector<int> owner;              // Player that gets the point of every game (-1 if none)
+  std::vector<int> free_games;         // Games without owner, free_slot is the position of a game in there
+  std::vector<int> free_slot;
+  std::vector<int> score, load;        // Final score and currently assigned games of every player
+  std::vector<std::vector<int>> incident;
+  long score_sum = 0;
+
+  // BFS state: players are visited if visit == epoch, via is the game that moves along the search tree edge.
+  // Players with dead == pass were reached by a failed search in the current augment pass
+  std::vector<int> visit, dead, via, queue;
+  int epoch = 0, pass = 0;
+
+  bool allowed(int g, int p) const {
+    return (p == player_a[g] && result[g] != 2) || (p == player_b[g] && result[g] != 1);
+  }
+
+  int other(int g, int p) const {
+    return p == player_a[g] ? player_b[g] : player_a[g];
+  }
+
+  // Takes the point of game g away from its player
+  void release(int g) {
+    load[owner[g]]--;
+    owner[g] = -1;
+    free_slot[g] = free_games.size();
+    free_games.push_back(g);
+  }
+
+  // Searches an augmenting path from every unassigned game. A failed search stays failed for the rest of the pass:
+  // the players it reached can't reach a free point, and augmenting paths never enter them. So they are skipped by
+  // the following searches, and a pass costs one full search plus one per placed game
+  void augment() {
+    ++pass;
+    for(size_t i = 0; i < free_games.size(); ) {
+      if(place(free_games[i])) continue; // The last free game moved to position i
+      for(const int x : queue) dead[x] = pass;
+      ++i;
+    }
+    ++pass;
+  }
+
+  void discover(int y, int g) {
+    if(visit[y] != epoch && dead[y] != pass) { visit[y] = epoch; via[y] = g; queue.push_back(y); }
+  }
+
+  // Gives the point of the unassigned game g to some player, along a shortest augmenting path that ends at a player
+  // with a free point. Returns if such a path exists
+  bool place(int g) {
+    ++epoch; queue.clear();
+    for(const int y : {player_a[g], player_b[g]}) {
+      if(allowed(g, y)) discover(y, g);
+    }
+
+    for(size_t i = 0; i < queue.size(); ++i) {
+      const int x = queue[i];
+      if(load[x] < score[x]) {
+        // Shift every game along the path one step forward
+        load[x]++;
+        for(int y = x; ; ) {
+          const int moved = via[y], previous = owner[moved];
+          owner[moved] = y;
+          if(moved == g) break;
+          y = previous;
+        }
+
+        const int last = free_games.back();
+        free_games[free_slot[g]] = last; free_slot[last] = free_slot[g];
+        free_games.pop_back();
+        return true;
+      }
+
+      // x is full: one of its games could go to its opponent instead
+      for(const int h : incident[x]) {
+        if(owner[h] == x && allowed(h, other(h, x))) discover(other(h, x), h);
+      }
     }
+    return false;
+  }
 };
 
 void solve() {
-  // ===== READ INPUT & BUILD GRAPH =====
+  // ===== READ INPUT =====
   int n, m; std:: cin >> n >> m;
-  int score_sum = 0;
-  
-  // 0  to      n - 1 -> Players
-  // n  to  n + m - 1 -> Games
-  graph G(n + m); 
-  edge_adder adder(G);
-  
-  const vertex_desc v_source = boost::add_vertex(G);
-  const vertex_desc v_sink = boost::add_vertex(G);
-  
-  // Connect Source -> Games and Games -> Players
+
+  std::vector<int> a(m), b(m), c(m);
   for(int i = 0; i < m; ++i) {
-    // Each game gives 1 point -> Connect source to game with capacity 1
-    adder.add_edge(v_source, n + i, 1);
-    
-    // Connect Game to Players depending on outcome
-    int a, b, c; std::cin >> a >> b >> c;
-    
-    if(c == 1) {         // Player a wins -> Connect to a
-      adder.add_edge(n + i, a, 1);
-    } else if (c == 2) { // Player b wins -> Connect to b
-      adder.add_edge(n + i, b, 1);
-    } else {             // Don't know -> Connect to both
-      adder.add_edge(n + i, a, 1);
-      adder.add_edge(n + i, b, 1);
-    }
+    std::cin >> a[i] >> b[i] >> c[i];
   }
-  
-  // Connect Players -> Sink
+
+  // ===== BUILD FLOW INCREMENTALLY =====
+  // Scores first, so that every game finds its player right away
+  ScoreFlow tournament(n);
   for(int i = 0; i < n; ++i) {
     int s; std::cin >> s;
-    score_sum += s;
-    
-    adder.add_edge(i, v_sink, s);
-  }
-  
-  // ===== CALCULATE MAX FLOW =====
-  int flow = boost::push_relabel_max_flow(G, v_source, v_sink);
-  
+    tournament.set_score(i, s);
+  }
+  for(int i = 0; i < m; ++i) {
+    tournament.add_game(a[i], b[i], c[i]);
+  }
+
   // ===== OUTPUT =====
-  if(score_sum == m && flow == score_sum) {
+  if(tournament.feasible()) {
     std::cout << "yes" << std::endl;
   } else {
     std::cout << "no" << std::endl;
@@ -85,8 +161,8 @@ void solve() {
 
 int main() {
   int n_tests; std::cin >> n_tests;
-  
+
   while(n_tests--) {
     solve();
   }
-}
\ No newline at end of file
+}
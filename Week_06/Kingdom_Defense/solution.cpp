@@ -1,9 +1,11 @@
 #include<iostream>
 #include<vector>
-#include<cmath>
+#include<utility>
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/push_relabel_max_flow.hpp>
+#include <boost/graph/successive_shortest_path_nonnegative_weights.hpp>
+#include <boost/graph/find_flow_cost.hpp>
 
 typedef boost::adjacency_list_traits<boost::vecS, boost::vecS, boost::directedS> traits;
 typedef boost::adjacency_list<boost::vecS, 
@@ -12,9 +14,11 @@ typedef boost::adjacency_list<boost::vecS,
                               boost::no_property,
                               boost::property<boost::edge_capacity_t, long,
                                               boost::property<boost::edge_residual_capacity_t, long,
-                                                              boost::property<boost::edge_reverse_t, traits::edge_descriptor>>>> graph;
+                                                              boost::property<boost::edge_reverse_t, traits::edge_descriptor,
+                                                                              boost::property<boost::edge_weight_t, long>>>>> graph;
 typedef traits::vertex_descriptor vertex_desc;
 typedef traits::edge_descriptor edge_desc;
+typedef boost::graph_traits<graph>::out_edge_iterator out_edge_it;
 
 
 class edge_adder {
@@ -23,15 +27,94 @@ class edge_adder {
   public:
     explicit edge_adder(graph &G) : G(G) {}
     
-    void add_edge(int from, int to, long capacity) {
+    edge_desc add_edge(int from, int to, long capacity, long cost) {
       auto c_map = boost::get(boost::edge_capacity, G);
       auto r_map = boost::get(boost::edge_reverse, G);
+      auto w_map = boost::get(boost::edge_weight, G);
       const auto e = boost::add_edge(from, to, G).first;
       const auto rev_e = boost::add_edge(to, from, G).first;
       c_map[e] = capacity;
       c_map[rev_e] = 0; // reverse edge has no capacity!
       r_map[e] = rev_e;
       r_map[rev_e] = e;
+      w_map[e] = cost;
+      w_map[rev_e] = -cost;
+      return e;
+    }
+};
+
+// Flow with lower and upper bounds on the edges and supplies (or demands) on the nodes.
+// All lower bounds are sent right away, which leaves every edge with capacity upper - lower and some imbalance at its
+// endpoints. A super source covers the positive imbalances and a super sink takes the negative ones: a valid flow
+// exists exactly if the max flow between them saturates all of these edges
+class BoundedFlow {
+  int n;
+  graph G;
+  edge_adder adder;
+  std::vector<long> imbalance;
+  std::vector<std::pair<edge_desc, long>> edges; // Reduced edge and lower bound of every added edge
+  long lower_cost = 0, total_cost = 0;
+
+  public:
+    static const long INF = 1L << 40;
+
+    explicit BoundedFlow(int n) : n(n), G(n + 2), adder(G), imbalance(n, 0) {}
+
+    // Adds an edge with lower <= flow <= upper and the given cost per unit. Returns its index for flow()
+    int add_edge(int from, int to, long lower, long upper, long cost = 0) {
+      imbalance[from] -= lower;
+      imbalance[to] += lower;
+      lower_cost += lower * cost;
+      edges.emplace_back(adder.add_edge(from, to, upper - lower, cost), lower);
+      return edges.size() - 1;
+    }
+
+    // The node sends out this much more than it receives (receives more if supply is negative)
+    void add_supply(int node, long supply) {
+      imbalance[node] += supply;
+    }
+
+    // Searches a valid flow, of minimum cost if min_cost is set (needs non-negative costs). Returns if one exists
+    bool solve(bool min_cost = false) {
+      const vertex_desc v_source = n, v_sink = n + 1;
+
+      long required = 0;
+      for(int i = 0; i < n; ++i) {
+        if(imbalance[i] > 0) {
+          adder.add_edge(v_source, i, imbalance[i], 0);
+          required += imbalance[i];
+        } else if(imbalance[i] < 0) {
+          adder.add_edge(i, v_sink, -imbalance[i], 0);
+        }
+      }
+
+      long flow = 0;
+      if(min_cost) {
+        boost::successive_shortest_path_nonnegative_weights(G, v_source, v_sink);
+        total_cost = lower_cost + boost::find_flow_cost(G);
+
+        auto c_map = boost::get(boost::edge_capacity, G);
+        auto rc_map = boost::get(boost::edge_residual_capacity, G);
+        out_edge_it e, eend;
+        for(boost::tie(e, eend) = boost::out_edges(v_source, G); e != eend; ++e) flow += c_map[*e] - rc_map[*e];
+      } else {
+        flow = boost::push_relabel_max_flow(G, v_source, v_sink);
+      }
+
+      return flow == required;
+    }
+
+    // Flow on the edge with the given index, after solve() found a valid flow
+    long flow(int edge) {
+      auto c_map = boost::get(boost::edge_capacity, G);
+      auto rc_map = boost::get(boost::edge_residual_capacity, G);
+      const edge_desc e = edges[edge].first;
+      return edges[edge].second + c_map[e] - rc_map[e];
+    }
+
+    // Cost of the flow, after solve(true) found a valid flow
+    long cost() const {
+      return total_cost;
     }
 };
 
@@ -39,23 +122,21 @@ void solve() {
   // ===== READ INPUT & BUILD GRAPH =====
   int l, p; std::cin >> l >> p;
   
-  graph G(l);
-  edge_adder adder(G);
-  
-  const vertex_desc v_source = boost::add_vertex(G);
-  const vertex_desc v_sink = boost::add_vertex(G);
+  // All soldiers end up in the node l, every location i sends at least d_i of them there (the ones that stay)
+  BoundedFlow kingdom(l + 1);
+  const int v_defense = l;
   
-  std::vector<int> in_capacities(l);
-  
-  int in_capacity = 0;
-  int out_capacity = 0;
+  long in_capacity = 0;
+  long out_capacity = 0;
   for(int i = 0; i < l; ++i) {
-    int d; std::cin >> in_capacities[i] >> d;
-    adder.add_edge(i, v_sink, d); // Only add "out_capacity"
+    int g, d; std::cin >> g >> d;
+    kingdom.add_supply(i, g);
+    kingdom.add_edge(i, v_defense, d, BoundedFlow::INF);
 
-    in_capacity += in_capacities[i];
+    in_capacity += g;
     out_capacity += d;
   }
+  kingdom.add_supply(v_defense, -in_capacity);
   
   if(in_capacity < out_capacity) {
     // Not enough soldiers 
@@ -65,24 +146,14 @@ void solve() {
   
   for(int i = 0; i < p; ++i) {
     int f, t, c, C; std::cin >> f >> t >> c >> C;
-    
-    // Adjust "in_capacities" based on minimum amount of soldiers along a path (c)
-    in_capacities[f] -= c;
-    in_capacities[t] += c;
-    
-    adder.add_edge(f, t, C - c);
+    kingdom.add_edge(f, t, c, C);
   }
   
-  // Add "in_capacities" as edges
-  for(int i = 0; i < l; ++i) {
-    adder.add_edge(v_source, i, std::max(in_capacities[i], 0));
-  }
-  
-  // ===== CALCULATE MAX FLOW =====
-  long flow = boost::push_relabel_max_flow(G, v_source, v_sink);
+  // ===== SEARCH VALID FLOW =====
+  const bool feasible = kingdom.solve();
 
   // ===== OUTPUT =====
-  if(flow >= out_capacity) {
+  if(feasible) {
     std::cout << "yes" << std::endl;
   } else {
     std::cout << "no" << std::endl;
@@ -96,4 +167,4 @@ int main() {
   while(n_tests--) {
     solve();
   }
-}
\ No newline at end of file
+}
@@ -1,98 +1,189 @@
 #include<iostream>
 #include<vector>
+#include<tuple>
+#include<algorithm>
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/push_relabel_max_flow.hpp>
-
-typedef boost::adjacency_list_traits<boost::vecS, boost::vecS, boost::directedS> traits;
-typedef boost::adjacency_list<boost::vecS, 
-                              boost::vecS, 
-                              boost::directedS, 
-                              boost::no_property,
-                              boost::property<boost::edge_capacity_t, long,
-                                              boost::property<boost::edge_residual_capacity_t, long,
-                                                              boost::property<boost::edge_reverse_t, traits::edge_descriptor>>>> graph;
-typedef traits::vertex_descriptor vertex_desc;
-typedef traits::edge_descriptor edge_desc;
-
-bool INCOMING = false;
-bool OUTGOING = true;
-
-int get_vertex_idx(int row, int col, bool outgoing, int n, int m) {
-  return row * m + col + n * m * outgoing;
-}
+// Max flow of knights out of the cave, with push-relabel on the implicit residual graph of the grid.
+// Every intersection (cell) can be passed c times and every hallway (including the ones leading out of the cave) once.
+// A cell has an entry node (2 * cell) and an exit node (2 * cell + 1), connected by its vertex capacity, but no edges are
+// ever built: the flow through every cell and the flow on every (cell, direction) are stored in fixed-stride arrays.
+// The grid is padded by a ring of border cells, which all act as the sink.
+// Only the first phase of push-relabel is needed, as the flow value is the excess that arrives at the sink
+class GridFlow {
+public:
+  GridFlow(int rows, int cols, int capacity)
+    : width(cols + 2), capacity(capacity), size((rows + 2) * (cols + 2)), sink(2 * size),
+      border(size, true), through(size, 0), hallway(4 * size, false),
+      excess(2 * size + 1, 0), height(2 * size + 1), current(2 * size, 0) {
+    for(int row = 1; row <= rows; ++row) {
+      for(int col = 1; col <= cols; ++col) border[row * width + col] = false;
+    }
+    delta[0] = -width; delta[1] = width; delta[2] = -1; delta[3] = 1; // Up, down, left, right
+
+    // Hallways leading out of the cave
+    for(int u = 0; u < size; ++u) {
+      if(border[u]) continue;
+      for(int d = 0; d < 4; ++d) {
+        if(border[u + delta[d]]) exits.push_back(4 * u + d);
+      }
+    }
+  }
+
+  // The source edges are saturated right away, so a knight is just excess at the entry of its cell
+  void add_knight(int row, int col) {
+    excess[2 * ((row + 1) * width + col + 1)]++;
+  }
+
+  int max_flow() {
+    const int max_height = 2 * size + 1;
+
+    // FIFO order of the active nodes (with excess and a path to the sink)
+    std::vector<int> active;
+    size_t head = 0;
+    long work = 0;
+    auto relabel_all = [&]() {
+      global_relabel();
+      active.clear(); head = 0; work = 0;
+      for(int x = 0; x < 2 * size; ++x) {
+        if(excess[x] > 0 && height[x] < max_height) active.push_back(x);
+      }
+    };
+    relabel_all();
+
+    while(head < active.size()) {
+      const int x = active[head++];
+
+      // Discharge x
+      while(excess[x] > 0 && height[x] < max_height) {
+        if(current[x] == ARCS) {
+          // Relabel to one above the lowest neighbour with residual capacity
+          int lowest = max_height;
+          for(int a = 0; a < ARCS; ++a) {
+            int y, residual; std::tie(y, residual) = arc(x, a);
+            if(residual > 0) lowest = std::min(lowest, height[y]);
+          }
+          height[x] = std::min(lowest + 1, max_height);
+          current[x] = 0;
+          work += ARCS;
+          continue;
+        }
+
+        int y, residual; std::tie(y, residual) = arc(x, current[x]);
+        if(residual > 0 && height[x] == height[y] + 1) {
+          const int amount = std::min(excess[x], residual);
+          push(x, current[x], amount);
+          excess[x] -= amount;
+          if(y != sink && excess[y] == 0) active.push_back(y);
+          excess[y] += amount;
+        } else {
+          current[x]++;
+        }
+      }
+
+      // Recompute exact heights from time to time, this also drops all excess that can't reach the sink anymore
+      if(work > 4 * size) relabel_all();
+    }
+
+    return excess[sink];
+  }
+
+private:
+  static const int ARCS = 5; // 4 directions and the arc between entry and exit of a cell
+
+  const int width, capacity, size, sink;
+  int delta[4];
+  std::vector<char> border;
+  std::vector<int> through;        // Flow through every cell (at most capacity)
+  std::vector<char> hallway;       // Flow from the exit of a cell into direction d, at index 4 * cell + d
+  std::vector<int> exits;          // Hallways (4 * cell + d) that lead out of the cave
+  std::vector<int> excess, height;
+  std::vector<char> current;       // Current arc of every node
 
-class edge_adder {
-  graph &G;
-  
-  public:
-    explicit edge_adder(graph &G) : G(G) {}
-    
-    void add_edge(int from, int to, long capacity) {
-      auto c_map = boost::get(boost::edge_capacity, G);
-      auto r_map = boost::get(boost::edge_reverse, G);
-      const auto e = boost::add_edge(from, to, G).first;
-      const auto rev_e = boost::add_edge(to, from, G).first;
-      c_map[e] = capacity;
-      c_map[rev_e] = 0; // reverse edge has no capacity!
-      r_map[e] = rev_e;
-      r_map[rev_e] = e;
+  // Target and residual capacity of arc a of node x
+  std::pair<int, int> arc(int x, int a) const {
+    const int u = x >> 1;
+    if(x & 1) {
+      // Exit: along a hallway, or back to the entry
+      if(a == 4) return {2 * u, through[u]};
+      const int v = u + delta[a];
+      return {border[v] ? sink : 2 * v, !hallway[4 * u + a]};
+    } else {
+      // Entry: into the exit, or back along a used hallway that leads into this cell
+      if(a == 4) return {2 * u + 1, capacity - through[u]};
+      const int v = u + delta[a];
+      return {2 * v + 1, !border[v] && hallway[4 * v + (a ^ 1)]};
     }
+  }
+
+  // Sends amount units of flow along arc a of node x
+  void push(int x, int a, int amount) {
+    const int u = x >> 1;
+    if(x & 1) {
+      if(a == 4) through[u] -= amount;
+      else hallway[4 * u + a] = true;
+    } else {
+      if(a == 4) through[u] += amount;
+      else hallway[4 * (u + delta[a]) + (a ^ 1)] = false;
+    }
+  }
+
+  // Sets every height to the exact residual distance to the sink, with a BFS backwards from the sink
+  void global_relabel() {
+    const int unreachable = 2 * size + 1;
+    std::fill(height.begin(), height.end(), unreachable);
+    std::fill(current.begin(), current.end(), 0);
+    height[sink] = 0;
+
+    std::vector<int> queue;
+    auto reach = [&](int x, int h) {
+      if(height[x] == unreachable) { height[x] = h; queue.push_back(x); }
+    };
+
+    for(const int e : exits) {
+      if(!hallway[e]) reach(2 * (e / 4) + 1, 1);
+    }
+
+    for(size_t i = 0; i < queue.size(); ++i) {
+      const int y = queue[i], u = y >> 1, h = height[y] + 1;
+      if(y & 1) {
+        // Into an exit: from its own entry, or from a neighbouring entry along a used hallway
+        if(through[u] < capacity) reach(2 * u, h);
+        for(int d = 0; d < 4; ++d) {
+          const int v = u + delta[d];
+          if(!border[v] && hallway[4 * u + d]) reach(2 * v, h);
+        }
+      } else {
+        // Into an entry: from its own exit, or from a neighbouring exit along a free hallway
+        if(through[u] > 0) reach(2 * u + 1, h);
+        for(int d = 0; d < 4; ++d) {
+          const int v = u + delta[d];
+          if(!border[v] && !hallway[4 * v + (d ^ 1)]) reach(2 * v + 1, h);
+        }
+      }
+    }
+  }
 };
 
 void solve() {
-  // ===== READ INPUT & BUILD GRAPH =====
+  // ===== READ INPUT =====
   int m, n, k, c; std::cin >> m >> n >> k >> c;
-  
-  // Build Graph
-  graph G(m * n * 2); // * 2 Since per node, we need 2 nodes to model vertex capacity
-  edge_adder adder(G);
-  
-  const vertex_desc v_source = boost::add_vertex(G);
-  const vertex_desc v_sink = boost::add_vertex(G);
-    
-  for(int row = 0; row < n; ++row) {
-    for(int col = 0; col < m; ++col) {
-      int v_incoming = get_vertex_idx(row, col, INCOMING, n, m);
-      int v_outgoing = get_vertex_idx(row, col, OUTGOING, n, m);
-      
-      // Connect incoming to outgoing
-      adder.add_edge(v_incoming, v_outgoing, c);
-      
-      // Connect to top intersection
-      if(row != 0) adder.add_edge(v_outgoing, get_vertex_idx(row - 1, col, INCOMING, n, m), 1);
-      else adder.add_edge(v_outgoing, v_sink, 1);
-      
-      // Connect to bottom intersection
-      if(row != n-1) adder.add_edge(v_outgoing, get_vertex_idx(row + 1, col, INCOMING, n, m), 1);
-      else adder.add_edge(v_outgoing, v_sink, 1);
-      
-      // Connect to left intersection
-      if(col != 0) adder.add_edge(v_outgoing, get_vertex_idx(row, col - 1, INCOMING, n, m), 1);
-      else adder.add_edge(v_outgoing, v_sink, 1);
-      
-      // Connect to right intersection
-      if(col != m-1) adder.add_edge(v_outgoing, get_vertex_idx(row, col + 1, INCOMING, n, m), 1);
-      else adder.add_edge(v_outgoing, v_sink, 1);
-    }
-  }
-    
-  // Connect source to knight positions
+
+  GridFlow cave(n, m, c);
   for(int i = 0; i < k; ++i) {
     int x, y; std::cin >> x >> y;
-    adder.add_edge(v_source, get_vertex_idx(y, x, INCOMING, n, m), 1);
+    cave.add_knight(y, x);
   }
-  
+
   // ===== CALCULATE MAX FLOW =====
-  int flow = boost::push_relabel_max_flow(G, v_source, v_sink);
-  
+  int flow = cave.max_flow();
+
   // ===== OUTPUT =====
   std::cout << flow << std::endl;
 }
 
 int main() {
   std::ios_base::sync_with_stdio(false);
-  
+
   int n_tests; std::cin >> n_tests;
   while(n_tests--) {
     solve();
@@ -1,69 +1,114 @@
 #include<iostream>
 #include<vector>
-#include <tuple>
+#include <cstdint>
+#include <cstdlib>
 #include <algorithm>
-#include <CGAL/Gmpq.h>
 
-// Intercept, Slope, Index
-typedef std::tuple<int64_t, CGAL::Gmpq, int> Biker;
+// Slope comparisons of num / den with den > 0. All coordinates are below 2^53, so numerators and denominators are
+// below 2^54 and the cross products fit exactly into 128 bits
+int compare_slopes(int64_t a_num, int64_t a_den, int64_t b_num, int64_t b_den) {
+  const __int128 lhs = (__int128) a_num * b_den;
+  const __int128 rhs = (__int128) b_num * a_den;
+  return (lhs > rhs) - (lhs < rhs);
+}
+
+int compare_abs_slopes(int64_t a_num, int64_t a_den, int64_t b_num, int64_t b_den) {
+  return compare_slopes(std::llabs(a_num), a_den, std::llabs(b_num), b_den);
+}
+
+// Returns the indices 0..n-1 sorted ascendingly by key, with an LSD radix sort on 16 bit digits.
+// Flipping the sign bit makes the unsigned order of the keys equal to their signed order
+std::vector<int> radix_order(const std::vector<int64_t> &keys) {
+  const int n = keys.size();
+  std::vector<uint64_t> key(n), key_tmp(n);
+  std::vector<int> order(n), order_tmp(n);
+  for(int i = 0; i < n; ++i) {
+    key[i] = (uint64_t) keys[i] ^ (1ULL << 63);
+    order[i] = i;
+  }
+
+  std::vector<int> count(1 << 16);
+  for(int shift = 0; shift < 64; shift += 16) {
+    std::fill(count.begin(), count.end(), 0);
+    for(int i = 0; i < n; ++i) count[(key[i] >> shift) & 0xFFFF]++;
+    if(count[(key[0] >> shift) & 0xFFFF] == n) continue; // All keys share this digit
+
+    int sum = 0;
+    for(int &c : count) { const int c_old = c; c = sum; sum += c_old; }
+    for(int i = 0; i < n; ++i) {
+      const int pos = count[(key[i] >> shift) & 0xFFFF]++;
+      key_tmp[pos] = key[i];
+      order_tmp[pos] = order[i];
+    }
+    key.swap(key_tmp);
+    order.swap(order_tmp);
+  }
+  return order;
+}
 
 void solve() {
   // ===== READ INPUT =====
   int n; std::cin >> n;
-  
-  std::vector<Biker> bikers; bikers.reserve(n);
+
+  // Intercept and slope num / den of every biker (structure of arrays)
+  std::vector<int64_t> intercept(n), num(n), den(n);
   for(int i = 0; i < n; ++i) {
     int64_t y_0, x_1, y_1; std::cin >> y_0 >> x_1 >> y_1;
-    bikers.emplace_back(y_0, CGAL::Gmpq(y_1 - y_0, x_1), i);
+    intercept[i] = y_0;
+    num[i] = y_1 - y_0;
+    den[i] = x_1;
   }
-  
+
   // ===== SOLVE ======
-  // Sort bikers descendingly by their intercept
-  std::sort(bikers.begin(), bikers.end(), [](const Biker &a, const Biker &b){
-    return std::get<0>(a) < std::get<0>(b);
-  });
-  
+  // Sort bikers ascendingly by their intercept, and lay out their slopes in this order for the sweeps
+  const std::vector<int> order = radix_order(intercept);
+  std::vector<int64_t> slope_num(n), slope_den(n);
+  for(int i = 0; i < n; ++i) {
+    slope_num[i] = num[order[i]];
+    slope_den[i] = den[order[i]];
+  }
+
   std::vector<bool> rides_forever(n, true);
   // Iterate from the top and eliminate all riders that can not ride forever
-  CGAL::Gmpq lowest_abs_slope = std::get<1>(bikers[0]);
+  int lowest_abs_slope = 0;
   for(int i = 1; i < n; ++i) {
-    CGAL::Gmpq curr_slope = std::get<1>(bikers[i]);
-    
+    const int64_t lowest_num = slope_num[lowest_abs_slope], lowest_den = slope_den[lowest_abs_slope];
+
     // Check if the riders will intersect (either both drive up or both drive down)
-    if(lowest_abs_slope > curr_slope) {
+    if(compare_slopes(lowest_num, lowest_den, slope_num[i], slope_den[i]) > 0) {
       // The bikers will cross -> Check who will continue by determining which has the lower abs slope
-      if(CGAL::abs(lowest_abs_slope) <= CGAL::abs(curr_slope)) {
-        rides_forever[std::get<2>(bikers[i])] = false;
+      if(compare_abs_slopes(lowest_num, lowest_den, slope_num[i], slope_den[i]) <= 0) {
+        rides_forever[order[i]] = false;
       } else {
-        lowest_abs_slope = curr_slope;
+        lowest_abs_slope = i;
       }
     } else {
       // The biker[i] has a lower slope, so it either drives furhter down or is a new `lowest_abs_slope`
-      if(CGAL::abs(lowest_abs_slope) >= CGAL::abs(curr_slope)) {
-        lowest_abs_slope = curr_slope;
+      if(compare_abs_slopes(lowest_num, lowest_den, slope_num[i], slope_den[i]) >= 0) {
+        lowest_abs_slope = i;
       }
     }
   }
-  
+
   // Iterate from the bottom and eliminate all riders that can not ride forever
   // Basically the exact same as the previous loop just from the bottom
-  lowest_abs_slope = std::get<1>(bikers[n-1]);
+  lowest_abs_slope = n - 1;
   for(int i = n - 2; i >= 0; --i) {
-    CGAL::Gmpq curr_slope = std::get<1>(bikers[i]);
+    const int64_t lowest_num = slope_num[lowest_abs_slope], lowest_den = slope_den[lowest_abs_slope];
 
-    if(lowest_abs_slope < curr_slope) {
-      if(CGAL::abs(lowest_abs_slope) < CGAL::abs(curr_slope)) {
-        rides_forever[std::get<2>(bikers[i])] = false;
+    if(compare_slopes(lowest_num, lowest_den, slope_num[i], slope_den[i]) < 0) {
+      if(compare_abs_slopes(lowest_num, lowest_den, slope_num[i], slope_den[i]) < 0) {
+        rides_forever[order[i]] = false;
       } else {
-        lowest_abs_slope = curr_slope;
+        lowest_abs_slope = i;
       }
     } else {
-      if(CGAL::abs(lowest_abs_slope) >= CGAL::abs(curr_slope)) {
-        lowest_abs_slope = curr_slope;
+      if(compare_abs_slopes(lowest_num, lowest_den, slope_num[i], slope_den[i]) >= 0) {
+        lowest_abs_slope = i;
       }
     }
   }
-  
+
   // ===== OUTPUT =====
   for(int i = 0; i < n; ++i) {
     if(rides_forever[i]) {
@@ -75,7 +120,7 @@ void solve() {
 
 int main() {
   std::ios_base::sync_with_stdio(false);
-  
+
   int n_tests; std::cin >> n_tests;
   while(n_tests--) { solve(); }
-}
\ No newline at end of file
+}
@@ -1,96 +1,215 @@
 #include<iostream>
 #include<vector>
 #include<string>
+#include<queue>
+#include<limits>
+#include<algorithm>
+#include<cstdlib>
 
-#include<boost/graph/adjacency_list.hpp>
-#include<boost/graph/push_relabel_max_flow.hpp>
-
-using index_map = std::unordered_map<std::pair<int, int>, int>;
-
-using traits = boost::adjacency_list_traits<boost::vecS, boost::vecS, boost::directedS>;
-using graph = boost::adjacency_list<boost::vecS, 
-                                    boost::vecS, 
-                                    boost::directedS, 
-                                    boost::no_property,
-                                    boost::property<boost::edge_capacity_t, long,
-                                                    boost::property<boost::edge_residual_capacity_t, long,
-                                                                    boost::property<boost::edge_reverse_t, traits::edge_descriptor>>>>;
-using vertex_desc = traits::vertex_descriptor;
-using edge_desc = traits::edge_descriptor;
-
-class edge_adder {
-  graph &G;
-  
-  public:
-    explicit edge_adder(graph &G) : G(G) {}
-    
-    void add_edge(int from, int to, long capacity) {
-      auto c_map = boost::get(boost::edge_capacity, G);
-      auto r_map = boost::get(boost::edge_reverse, G);
-      const auto e = boost::add_edge(from, to, G).first;
-      const auto rev_e = boost::add_edge(to, from, G).first;
-      c_map[e] = capacity;
-      c_map[rev_e] = 0; // reverse edge has no capacity!
-      r_map[e] = rev_e;
-      r_map[rev_e] = e;
+// Maximum bipartite matching (Hopcroft-Karp) on the implicit graph of a grid: cells with (r + c) even form the left side,
+// cells with (r + c) odd the right side and every free cell is connected to the free cells at the given offsets.
+// No explicit graph is built. The grid is padded with a border of blocked cells, so the neighbours of a cell
+// are just fixed index deltas without any bounds checks
+class GridMatching {
+public:
+  GridMatching(int h, int w, const std::vector<char> &free, const std::vector<std::pair<int, int>> &offsets) {
+    int pad = 0;
+    for(const auto &offset : offsets) pad = std::max({pad, std::abs(offset.first), std::abs(offset.second)});
+    width = w + 2 * pad;
+
+    const int size = (h + 2 * pad) * width;
+    padded.assign(size, false); mate.assign(size, -1); dist.resize(size); next.resize(size);
+    for(const auto &offset : offsets) deltas.push_back(offset.first * width + offset.second);
+
+    for(int r = 0; r < h; ++r) {
+      for(int c = 0; c < w; ++c) {
+        const int u = (r + pad) * width + c + pad;
+        padded[u] = free[r * w + c];
+        if(padded[u] && (r + c) % 2 == 0) left.push_back(u);
+      }
+    }
+  }
+
+  // Size of a maximum matching
+  int max_matching() {
+    int matching = initial_matching();
+
+    while(bfs()) {
+      for(const int u : left) {
+        if(mate[u] == -1 && dfs(u)) matching++;
+      }
+    }
+    return matching;
+  }
+
+private:
+  static const int INF = std::numeric_limits<int>::max();
+
+  int width;                         // Width of the padded grid
+  std::vector<char> padded;          // Free cells of the padded grid
+  std::vector<int> deltas;           // Index differences to the neighbours
+  std::vector<int> left;             // All free left cells
+  std::vector<int> mate;             // Matched partner of every cell (-1 if unmatched)
+  std::vector<int> dist;             // BFS layer of the left cells
+  std::vector<int> next;             // Next neighbour to try in the DFS (kept for the whole phase)
+
+  // Returns the neighbour k of cell u if it is free, -1 otherwise
+  int neighbour(int u, int k) const {
+    const int v = u + deltas[k];
+    return padded[v] ? v : -1;
+  }
+
+  // Returns the first unmatched free neighbour of cell u, -1 if there is none
+  int unmatched_neighbour(int u) const {
+    for(int k = 0; k < (int) deltas.size(); ++k) {
+      const int v = neighbour(u, k);
+      if(v != -1 && mate[v] == -1) return v;
+    }
+    return -1;
+  }
+
+  // Karp-Sipser heuristic: a cell with a single unmatched neighbour left can always be matched to it,
+  // otherwise an arbitrary edge is taken. On grids this leaves very few cells for the augmenting phases
+  int initial_matching() {
+    std::vector<int> degree(padded.size(), 0);
+    std::vector<int> forced;
+    for(int u = 0; u < (int) padded.size(); ++u) {
+      if(!padded[u]) continue;
+      for(int k = 0; k < (int) deltas.size(); ++k) degree[u] += neighbour(u, k) != -1;
+      if(degree[u] == 1) forced.push_back(u);
+    }
+
+    int matching = 0;
+    auto match = [&](int u, int v) {
+      mate[u] = v; mate[v] = u; matching++;
+      for(const int x : {u, v}) {
+        for(int k = 0; k < (int) deltas.size(); ++k) {
+          const int y = neighbour(x, k);
+          if(y != -1 && mate[y] == -1 && --degree[y] == 1) forced.push_back(y);
+        }
+      }
+    };
+
+    size_t scan = 0;
+    while(true) {
+      while(!forced.empty()) {
+        const int u = forced.back(); forced.pop_back();
+        if(mate[u] != -1) continue;
+        const int v = unmatched_neighbour(u);
+        if(v != -1) match(u, v);
+      }
+
+      // No forced cell left, take the next free edge
+      while(scan < left.size()) {
+        const int u = left[scan++];
+        const int v = mate[u] == -1 ? unmatched_neighbour(u) : -1;
+        if(v != -1) {
+          match(u, v);
+          break;
+        }
+      }
+      if(forced.empty() && scan == left.size()) break;
+    }
+    return matching;
+  }
+
+  // Layers the left cells by alternating path length from the unmatched ones, up to the layer of the shortest
+  // augmenting paths. Returns if an augmenting path exists
+  bool bfs() {
+    std::queue<int> queue;
+    for(const int u : left) {
+      next[u] = 0;
+      dist[u] = mate[u] == -1 ? 0 : INF;
+      if(mate[u] == -1) queue.push(u);
+    }
+
+    int limit = INF;
+    while(!queue.empty()) {
+      const int u = queue.front(); queue.pop();
+      if(dist[u] >= limit) break;
+
+      for(int k = 0; k < (int) deltas.size(); ++k) {
+        const int v = neighbour(u, k);
+        if(v == -1) continue;
+
+        const int x = mate[v];
+        if(x == -1) {
+          limit = dist[u] + 1;
+        } else if(dist[x] == INF) {
+          dist[x] = dist[u] + 1;
+          queue.push(x);
+        }
+      }
+    }
+    return limit != INF;
+  }
+
+  // Iterative DFS along the BFS layers from the unmatched left cell root. Augments the matching if a path is found.
+  // Neighbours that were already tried in this phase are never tried again
+  bool dfs(int root) {
+    std::vector<int> stack = {root};
+
+    while(!stack.empty()) {
+      const int u = stack.back();
+      if(next[u] == (int) deltas.size()) {
+        // Dead end, never visit u again in this phase
+        dist[u] = INF;
+        stack.pop_back();
+        if(!stack.empty()) next[stack.back()]++;
+        continue;
+      }
+
+      const int v = neighbour(u, next[u]);
+      if(v == -1) {
+        next[u]++;
+      } else if(mate[v] == -1) {
+        // Augmenting path found, flip all edges along the stack
+        for(const int x : stack) {
+          const int y = neighbour(x, next[x]);
+          mate[x] = y;
+          mate[y] = x;
+        }
+        return true;
+      } else if(dist[mate[v]] == dist[u] + 1) {
+        stack.push_back(mate[v]);
+      } else {
+        next[u]++;
+      }
     }
+    return false;
+  }
 };
 
 void solve() {
   // ===== READ INPUT =====
-  // Read Input
   int w, h; std::cin >> w >> h;
-  int num_nodes = 0;
-  
-  std::vector<std::vector<bool>> garden(h, std::vector<bool>(w, false));
+  int num_nodes = 0, num_white = 0;
+
+  std::vector<char> garden(h * w, false);
   for(int r = 0; r < h; ++r) {
     std::string row; std::cin >> row;
-    
+
     for(int c = 0; c < w; ++c) {
       if(row[c] == '.') {
-        garden[r][c] = true;
+        garden[r * w + c] = true;
         num_nodes++;
+        num_white += (r + c) % 2 == 0;
       }
     }
   }
-  
-  if(num_nodes % 2 == 1) {
-    // Can't tile an odd numbered of spaces
+
+  if(num_nodes % 2 == 1 || 2 * num_white != num_nodes) {
+    // Can't tile an odd numbered of spaces, and every tile covers exactly one white and one black space
     std::cout << "no" << std::endl;
     return;
   }
-  
-  // Build Graph
-  graph G(w * h); // It would make more sense to only add num_nodes nodes, but this makes it easier to code
-  edge_adder adder(G);
-  
-  const vertex_desc v_source = boost::add_vertex(G);
-  const vertex_desc v_sink = boost::add_vertex(G);
 
-  for(int r = 0; r < h; ++r) {
-    for(int c = 0; c < w; ++c) {
-      if(garden[r][c]) {
-        int v_idx = r * w + c;
-
-        // Add alternating source and sink connections in checkerboard pattern
-        if((r + c) % 2 == 0) {
-          adder.add_edge(v_source, v_idx, 1);
-          if(r != h-1 && garden[r+1][c]) adder.add_edge(v_idx, (r+1) * w + c, 1);
-          if(c != w-1 && garden[r][c+1]) adder.add_edge(v_idx, r * w + (c + 1), 1);
-        } else {
-          adder.add_edge(v_idx, v_sink, 1);
-          if(r != h-1 && garden[r+1][c]) adder.add_edge((r+1) * w + c, v_idx, 1);
-          if(c != w-1 && garden[r][c+1]) adder.add_edge(r * w + (c + 1), v_idx, 1);
-        }
-      }
-    }
-  }
-  
-  // ===== CALCULATE MAX FLOW =====
-  int flow = boost::push_relabel_max_flow(G, v_source, v_sink);
-  
+  // ===== CALCULATE MAXIMUM MATCHING =====
+  const std::vector<std::pair<int, int>> offsets = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+  GridMatching matching(h, w, garden, offsets);
+
   // ===== OUTPUT =====
-  if(flow * 2 == num_nodes) {
+  if(matching.max_matching() * 2 == num_nodes) {
     std::cout << "yes" << std::endl;
   } else {
     std::cout << "no" << std::endl;
@@ -98,6 +217,8 @@ void solve() {
 }
 
 int main() {
+  std::ios_base::sync_with_stdio(false);
+
   int n_tests; std::cin >> n_tests;
   while(n_tests--) {
     solve();
@@ -1,46 +1,104 @@
 #include<iostream>
+#include<iomanip>
 #include<vector>
+#include<algorithm>
+#include<cstddef>
 
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Delaunay_triangulation_2.h>
+#include <CGAL/spatial_sort.h>
+#include <CGAL/Spatial_sort_traits_adapter_2.h>
+#include <CGAL/property_map.h>
 
 using K = CGAL::Exact_predicates_inexact_constructions_kernel;
 using Triangulation = CGAL::Delaunay_triangulation_2<K>;
 using Point = K::Point_2;
+using Vertex_handle = Triangulation::Vertex_handle;
+using Sort_traits = CGAL::Spatial_sort_traits_adapter_2<K, CGAL::Pointer_property_map<Point>::type>;
 
+// Number of consecutive (spatially sorted) queries that one thread answers in a row
+const int CHUNK = 4096;
+
+// Walks greedily from vertex v to the nearest vertex of the query point q. In a Delaunay triangulation every vertex
+// that is not the nearest one has a neighbour that is strictly closer to q, so the walk always ends at the nearest.
+// It only reads the triangulation and can run in parallel
+Vertex_handle walk_to_nearest(const Triangulation &t, Vertex_handle v, const Point &q) {
+  while(true) {
+    Vertex_handle closest = v;
+    Triangulation::Vertex_circulator w = t.incident_vertices(v), done = w;
+    do {
+      if(!t.is_infinite(w) && CGAL::has_smaller_distance_to_point(q, w->point(), closest->point())) closest = w;
+    } while(++w != done);
+
+    if(closest == v) return v;
+    v = closest;
+  }
+}
 
 int main() {
   std::ios_base::sync_with_stdio(false);
-  
+
   while(true) {
     // ===== READ INPUT =====
     int n; std::cin >> n;
     if (n == 0) break;  // Test if input was terminated
-    
+
     std::vector<Point> restaurants(n);
     for(int i = 0; i < n; ++i) {
       int x, y; std::cin >> x >> y;
       restaurants[i] = Point(x, y);
     }
-    
+
     int m; std::cin >> m;
     std::vector<Point> new_restaurants(m);
     for(int i = 0; i < m; ++i) {
       int x, y; std::cin >> x >> y;
       new_restaurants[i] = Point(x, y);
     }
-    
+
     // ===== CONSTRUCT TRIANGULATION & CALCULATE DISTANCEES =====
     Triangulation t;
     t.insert(restaurants.begin(), restaurants.end());
-    
+
+    // Answer the queries along a Hilbert curve, so every walk starts at the answer of a nearby query
+    std::vector<std::ptrdiff_t> order(m);
+    for(int i = 0; i < m; ++i) order[i] = i;
+    CGAL::spatial_sort(order.begin(), order.end(), Sort_traits(CGAL::make_property_map(new_restaurants)));
+
+    std::vector<K::FT> distances(m);
+    if(t.dimension() < 2) {
+      // All restaurants on a line (or only one), no neighbourhood to walk on
+      for(int i = 0; i < m; ++i) {
+        const Point &q = new_restaurants[i];
+        distances[i] = CGAL::squared_distance(q, t.nearest_vertex(q)->point());
+      }
+    } else {
+      // The first walk of every chunk starts at the answer of the previous chunk's first query
+      const int chunks = (m + CHUNK - 1) / CHUNK;
+      std::vector<Vertex_handle> starts(chunks);
+      Vertex_handle hint = t.finite_vertices_begin();
+      for(int c = 0; c < chunks; ++c) {
+        hint = starts[c] = walk_to_nearest(t, hint, new_restaurants[order[c * CHUNK]]);
+      }
+
+      #ifdef _OPENMP
+      #pragma omp parallel for schedule(dynamic)
+      #endif
+      for(int c = 0; c < chunks; ++c) {
+        Vertex_handle v = starts[c];
+        for(int i = c * CHUNK; i < std::min(m, (c + 1) * CHUNK); ++i) {
+          const Point &q = new_restaurants[order[i]];
+          v = walk_to_nearest(t, v, q);
+          distances[order[i]] = CGAL::squared_distance(q, v->point());
+        }
+      }
+    }
+
     // Disable scientific notation (e+10) in output
     std::cout << std::setprecision(0) << std::fixed;
-    for(const Point& query_point : new_restaurants) {
-      Point closest_point = t.nearest_vertex(query_point)->point();
-      K::FT distance = CGAL::squared_distance(query_point, closest_point);
-      
-      std::cout << distance << std::endl;
+    for(int i = 0; i < m; ++i) {
+      std::cout << distances[i] << "\n";
     }
+    std::cout << std::flush;
   }
-}
\ No newline at end of file
+}
@@ -1,22 +1,17 @@
 #include <iostream>
 #include <vector>
-#include <cmath>
 #include <string>
-#include <set>
-#include <queue>
-
-// ===== BOOST INCLUDES AND TYPEDEFS =====
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/bipartite.hpp>
-#include <boost/graph/connected_components.hpp>
-
-typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> graph;
+#include <algorithm>
+#include <cstddef>
 
 // ===== CGAL INCLUDES AND TYPEDEFS =====
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Delaunay_triangulation_2.h>
 #include <CGAL/Triangulation_vertex_base_with_info_2.h>
 #include <CGAL/Triangulation_face_base_2.h>
+#include <CGAL/spatial_sort.h>
+#include <CGAL/Spatial_sort_traits_adapter_2.h>
+#include <CGAL/property_map.h>
 
 typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
 
@@ -34,111 +29,185 @@ typedef Delaunay::Vertex_circulator Vertex_circulator;
 typedef K::Point_2               Point;
 typedef std::pair<Point, Index> IPoint;
 
+typedef CGAL::Spatial_sort_traits_adapter_2<K, CGAL::Pointer_property_map<Point>::type> Sort_traits;
+
+// Number of consecutive (spatially sorted) query points that one thread locates in a row
+const int CHUNK = 4096;
+
+// Root of x in the flat union-find forest (with path halving)
+int find(std::vector<int> &parent, int x) {
+  while(parent[x] != x) {
+    parent[x] = parent[parent[x]];
+    x = parent[x];
+  }
+  return x;
+}
+
+// Moves from v to a Delaunay neighbour that is closer to q as long as there is one. This ends at the nearest vertex
+// of q (a vertex that is not the nearest always has a closer neighbour) and never modifies the triangulation
+Vertex_handle walk_to_nearest(const Delaunay &t, Vertex_handle v, const Point &q) {
+  while(true) {
+    Vertex_handle closest = v;
+    Vertex_circulator w = t.incident_vertices(v), done = w;
+    do {
+      if(!t.is_infinite(w) && CGAL::has_smaller_distance_to_point(q, w->point(), closest->point())) closest = w;
+    } while(++w != done);
+
+    if(closest == v) return v;
+    v = closest;
+  }
+}
+
+// Checks that the stations can be split into two frequencies without interferences. Colors every component along
+// the Delaunay edges of length <= r, then compares every station with all other stations within r. These are found
+// with a BFS over the Delaunay graph that stays inside the disk of radius r. A station with more than 5 others in its
+// disk always interferes: two of them are at most 60 degrees apart and thus within r of each other, forming a triangle
+bool two_colorable(const Delaunay &t, int n, long r_squared) {
+  if(t.dimension() < 1) return true; // A single station
+
+  std::vector<Vertex_handle> handle(n);
+  for(Vertex_iterator v = t.finite_vertices_begin(); v != t.finite_vertices_end(); ++v) handle[v->info()] = v;
+
+  // BFS coloring (every station is pushed once)
+  std::vector<int> color(n, -1), queue; queue.reserve(n);
+  for(int s = 0; s < n; ++s) {
+    if(color[s] != -1) continue;
+    color[s] = 0;
+    queue.assign(1, s);
+
+    for(size_t i = 0; i < queue.size(); ++i) {
+      const Vertex_handle u = handle[queue[i]];
+      Vertex_circulator w = t.incident_vertices(u), done = w;
+      do {
+        if(t.is_infinite(w) || color[w->info()] != -1) continue;
+        if(CGAL::squared_distance(u->point(), w->point()) <= r_squared) {
+          color[w->info()] = 1 - color[u->info()];
+          queue.push_back(w->info());
+        }
+      } while(++w != done);
+    }
+  }
+
+  // Local check of every station against its (small) disk
+  std::vector<int> seen(n, -1);
+  int local[7];
+  for(int s = 0; s < n; ++s) {
+    const Point &center = handle[s]->point();
+    int count = 1;
+    local[0] = s; seen[s] = s;
+
+    for(int i = 0; i < count; ++i) {
+      Vertex_circulator w = t.incident_vertices(handle[local[i]]), done = w;
+      do {
+        if(t.is_infinite(w) || seen[w->info()] == s) continue;
+        if(CGAL::squared_distance(center, w->point()) <= r_squared) {
+          if(color[w->info()] == color[s] || count == 6) return false;
+          seen[w->info()] = s;
+          local[count++] = w->info();
+        }
+      } while(++w != done);
+    }
+  }
+  return true;
+}
 
 void solve() {
   // ===== READ INPUT =====
   int n, m, r; std::cin >> n >> m >> r;
-  long r_squared = std::pow(r, 2);
-  
+  const long r_squared = (long) r * r;
+
   std::vector<IPoint> stations; stations.reserve(n);
-  std::vector<IPoint> holmes_positions; holmes_positions.reserve(m);
-  std::vector<IPoint> watson_positions; watson_positions.reserve(m);
-  
+  std::vector<Point> clues(2 * m); // Holmes at 2i, Watson at 2i + 1
+
   for(int i = 0; i < n; ++i) {
     int x, y; std::cin >> x >> y;
     stations.emplace_back(Point(x, y), i);
   }
   for(int i = 0; i < m; ++i) {
     int a_x, a_y, b_x, b_y; std::cin >> a_x >> a_y >> b_x >> b_y;
-    holmes_positions.emplace_back(Point(a_x, a_y), i);
-    watson_positions.emplace_back(Point(b_x, b_y), i);
+    clues[2 * i] = Point(a_x, a_y);
+    clues[2 * i + 1] = Point(b_x, b_y);
   }
-  
+
   // ===== SOLVE =====
-  // Build graph using Triangulation
-  // Note, that we are not able to just loop over all edges and keep those who are shorter than r
-  // This is because the Triangulation will just give us the edges for the shortest distances "around" each vertex v
-  // However, there might be other vertices that still lie in the radius of r
-  // but the Triangulation does not directly connect them to v, as there is a closer vertex
-  // Therefore, we need to do a BFS from all nodes to determine their connectivity
   Delaunay t;
   t.insert(stations.begin(), stations.end());
-  
-  graph G(n);
-  for (Vertex_iterator v = t.finite_vertices_begin(); v != t.finite_vertices_end(); ++v) {
-    // Perform BFS for every Vertex to determine its connectivity
-    std::queue<Vertex_handle> q;
-    std::set<Vertex_handle> visited;
-    
-    q.push(v);
-    visited.insert(v);
-    
-    while(!q.empty()) {
-      Vertex_handle curr_v = q.front(); q.pop();
-      
-      // Connect v to curr_v, as only vertices within radius r are pushed to q
-      if(v->info() != curr_v->info()) {
-        boost::add_edge(v->info(), curr_v->info(), G);
+
+  // Without a valid frequency assignment no clue can be transmitted. Early termination
+  if(!two_colorable(t, n, r_squared)) {
+    std::cout << std::string(m, 'n') << std::endl;
+    return;
+  }
+
+  // Two stations are connected iff they are connected by Delaunay edges of length <= r (the Euclidean minimum
+  // spanning tree is part of the Delaunay triangulation)
+  std::vector<int> component(n);
+  for(int i = 0; i < n; ++i) component[i] = i;
+  for(Edge_iterator e = t.finite_edges_begin(); e != t.finite_edges_end(); ++e) {
+    if(t.segment(e).squared_length() <= r_squared) {
+      const int u = e->first->vertex((e->second + 1) % 3)->info();
+      const int v = e->first->vertex((e->second + 2) % 3)->info();
+      component[find(component, u)] = find(component, v);
+    }
+  }
+  for(int i = 0; i < n; ++i) component[i] = find(component, i);
+
+  // Locate the nearest station of all clue positions as one batch: in spatial order, every walk starts at the
+  // previous answer, and chunks of the order are handled in parallel
+  std::vector<std::ptrdiff_t> order(2 * m);
+  for(int i = 0; i < 2 * m; ++i) order[i] = i;
+  CGAL::spatial_sort(order.begin(), order.end(), Sort_traits(CGAL::make_property_map(clues)));
+
+  std::vector<Vertex_handle> nearest(2 * m);
+  if(t.dimension() < 2) {
+    for(int i = 0; i < 2 * m; ++i) nearest[i] = t.nearest_vertex(clues[i]);
+  } else {
+    const int chunks = (2 * m + CHUNK - 1) / CHUNK;
+    std::vector<Vertex_handle> starts(chunks);
+    Vertex_handle hint = t.finite_vertices_begin();
+    for(int c = 0; c < chunks; ++c) {
+      hint = starts[c] = walk_to_nearest(t, hint, clues[order[c * CHUNK]]);
+    }
+
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+    #endif
+    for(int c = 0; c < chunks; ++c) {
+      Vertex_handle v = starts[c];
+      for(int i = c * CHUNK; i < std::min(2 * m, (c + 1) * CHUNK); ++i) {
+        v = walk_to_nearest(t, v, clues[order[i]]);
+        nearest[order[i]] = v;
       }
-      
-      // Iterate over all neighbors and potentially add them to q
-      Vertex_circulator neighbor_v = t.incident_vertices(curr_v);
-      do {
-        if(
-            !t.is_infinite(neighbor_v) && // Check if the neighbor is the infinite vertex (happens at boundary)
-            visited.find(neighbor_v) == visited.end() && // Check if neighbor has been visited before
-            CGAL::squared_distance(v->point(), neighbor_v->point()) <= r_squared // Check if neighbor is close enough
-          ) {
-            q.push(neighbor_v);
-            visited.insert(neighbor_v);
-          }
-      } while(++neighbor_v != t.incident_vertices(curr_v));
     }
   }
-  
-  // Check if G is bipartite. If not early termination
-  if(!is_bipartite(G)) {
-    std::cout << std::string(m, 'n') << std::endl;
-    return;
-  } 
-  
-  // Determine the connected components, to quickly check if a_i and b_i are connected
-  std::vector<int> component_map(n);
-  boost::connected_components(G, &component_map[0]);
-  
+
   // Check for every pair a_i b_i if they are connected/reachable
+  std::string answers(m, 'n');
   for(int i = 0; i < m; ++i) {
-    Point a = holmes_positions[i].first;
-    Point b = watson_positions[i].first;
-    
+    const Point &a = clues[2 * i], &b = clues[2 * i + 1];
+
     // Check if they are "directly reachable"
     if(CGAL::squared_distance(a, b) <= r_squared) {
-      std::cout << "y";
+      answers[i] = 'y';
       continue;
-    } 
-    
-    Vertex_handle neighbor_a = t.nearest_vertex(a);
-    Vertex_handle neighbor_b = t.nearest_vertex(b);
-    
-    long dist_a = CGAL::squared_distance(a, neighbor_a->point());
-    long dist_b = CGAL::squared_distance(b, neighbor_b->point());
+    }
 
     // Check if a and b are close enough to the stations and if they are in the same component
-    if(dist_a <= r_squared && dist_b <= r_squared && 
-       component_map[neighbor_a->info()] == component_map[neighbor_b->info()]) {
-        std::cout << "y";   
-     } else {
-        std::cout << "n";
-     }
+    const Vertex_handle neighbor_a = nearest[2 * i], neighbor_b = nearest[2 * i + 1];
+    if(CGAL::squared_distance(a, neighbor_a->point()) <= r_squared &&
+       CGAL::squared_distance(b, neighbor_b->point()) <= r_squared &&
+       component[neighbor_a->info()] == component[neighbor_b->info()]) {
+      answers[i] = 'y';
+    }
   }
-  std::cout << std::endl;
+  std::cout << answers << std::endl;
 }
 
 int main() {
   std::ios_base::sync_with_stdio(false);
-  
+
   int n_tests; std::cin >> n_tests;
   while(n_tests--) {
     solve();
   }
-}
\ No newline at end of file
+}
@@ -1,21 +1,20 @@
 #include <iostream>
 #include <vector>
-#include <limits>
+#include <cmath>
 #include <algorithm>
 
-#include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
-#include <CGAL/Delaunay_triangulation_2.h>
-
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Delaunay_triangulation_2.h>
 #include <CGAL/Triangulation_vertex_base_with_info_2.h>
 #include <CGAL/Triangulation_face_base_2.h>
 
 typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
-typedef CGAL::Delaunay_triangulation_2<K>  Triangulation;
+typedef CGAL::Triangulation_vertex_base_with_info_2<int, K> Vb;
+typedef CGAL::Triangulation_face_base_2<K> Fb;
+typedef CGAL::Triangulation_data_structure_2<Vb, Fb> Tds;
+typedef CGAL::Delaunay_triangulation_2<K, Tds>  Triangulation;
 
-typedef Triangulation::Finite_vertices_iterator VertexIterator;
-typedef Triangulation::Edge_circulator EdgeCirculator;
+typedef Triangulation::Finite_edges_iterator EdgeIterator;
 
 typedef K::Point_2 Point;
 
@@ -31,6 +30,24 @@ int squared_distance_to_time(K::FT d) {
   return out;
 }
 
+// Returns the values at the given percentiles (ascending, 0 to 100) of values, where percentile p is the element
+// at index floor(p * n / 100) of the sorted order (clamped to n - 1). Each nth_element only partitions the part
+// behind the previous percentile, so no full sort is needed. Reorders values
+std::vector<double> select_percentiles(std::vector<double> &values, const std::vector<int> &percents) {
+  const long n = values.size();
+  std::vector<double> selected;
+  auto begin = values.begin();
+  for(const int p : percents) {
+    const auto kth = values.begin() + std::min(n - 1, p * n / 100);
+    if(kth >= begin) {
+      std::nth_element(begin, kth, values.end());
+      begin = kth + 1;
+    }
+    selected.push_back(*kth);
+  }
+  return selected;
+}
+
 int main() {
   std::ios_base::sync_with_stdio(false);
   
@@ -41,10 +58,10 @@ int main() {
     
     int l, b, r, t; std::cin >> l >> b >> r >> t;
     
-    std::vector<Point> points; points.reserve(n);
+    std::vector<std::pair<Point, int>> points; points.reserve(n);
     for(int i = 0; i < n; ++i) {
       int x, y; std::cin >> x >> y;
-      points.emplace_back(x, y);
+      points.emplace_back(Point(x, y), i);
     }
     
     // ===== TRIANGULATION =====
@@ -52,40 +69,36 @@ int main() {
     tri.insert(points.begin(), points.end());
     
     // ===== DETERMINE DEATH DISTANCES =====
-    std::vector<double> death_distances; death_distances.reserve(n);
-    for(VertexIterator v = tri.finite_vertices_begin(); v != tri.finite_vertices_end(); ++v) {
-      Point p = v->point();
-      
-      // Calculate distance to border
+    // Start with the (squared) distance to the border, independently for every germ
+    std::vector<double> death_distances(n);
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+    #endif
+    for(int i = 0; i < n; ++i) {
+      const Point &p = points[i].first;
       double x_dist = std::min(p.x() - l, r - p.x());
       double y_dist = std::min(p.y() - b, t - p.y());
       double border_dist = std::min(x_dist, y_dist);
-      double squared_border_dist = std::pow(border_dist, 2);
-      
-      // Find the shortest edge distance
-      double shortest_edge = std::numeric_limits<double>::max();
-      
-      EdgeCirculator e = tri.incident_edges(v);
-      if(e != 0) {  // Check if the circulator is valid
-        do {
-          if (!tri.is_infinite(e)) {  
-            // Note, we have to divide by 4 here as both germs grow towards each other
-            // Therefore we have to divide by 2, but since we are considering squared distances
-            // we divide by 4
-            shortest_edge = std::min(shortest_edge, tri.segment(e).squared_length() / 4);
-          }
-        } while (++e != tri.incident_edges(v));
-      }
-      
-      // Add the death distance to the vector
-      death_distances.push_back(std::min(squared_border_dist, shortest_edge));
+      death_distances[i] = border_dist * border_dist;
+    }
+    
+    // Every Delaunay edge once, for both of its endpoints. The nearest neighbour of a germ is always connected to it.
+    // Note, we have to divide by 4 here as both germs grow towards each other
+    // Therefore we have to divide by 2, but since we are considering squared distances we divide by 4
+    for(EdgeIterator e = tri.finite_edges_begin(); e != tri.finite_edges_end(); ++e) {
+      const int u = e->first->vertex(tri.cw(e->second))->info();
+      const int v = e->first->vertex(tri.ccw(e->second))->info();
+      const double d = tri.segment(e).squared_length() / 4;
+      death_distances[u] = std::min(death_distances[u], d);
+      death_distances[v] = std::min(death_distances[v], d);
     }
     
     // ==== CALCULATE QUERY TIMES =====
-    std::sort(death_distances.begin(), death_distances.end());
+    // First, median and last germ to die (further percentiles, e.g. 90 or 99, can be added to the list)
+    const std::vector<double> selected = select_percentiles(death_distances, {0, 50, 100});
     
-    std::cout << squared_distance_to_time(death_distances[0]) << " " <<
-                squared_distance_to_time(death_distances[std::floor(death_distances.size() / 2)]) << " " <<
-                 squared_distance_to_time(death_distances[death_distances.size() - 1]) << std::endl;
+    std::cout << squared_distance_to_time(selected[0]) << " " <<
+                squared_distance_to_time(selected[1]) << " " <<
+                 squared_distance_to_time(selected[2]) << std::endl;
   }
 }
\ No newline at end of file
@@ -1,15 +1,22 @@
 #include <iostream>
 #include <vector>
-#include <queue>
+#include <tuple>
+#include <string>
 #include <limits>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
 
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Delaunay_triangulation_2.h>
 #include <CGAL/Triangulation_face_base_with_info_2.h>
+#include <CGAL/spatial_sort.h>
+#include <CGAL/Spatial_sort_traits_adapter_2.h>
+#include <CGAL/property_map.h>
 
 typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
 typedef CGAL::Triangulation_vertex_base_2<K> Vb;
-typedef CGAL::Triangulation_face_base_with_info_2<double, K> Fb;
+typedef CGAL::Triangulation_face_base_with_info_2<int, K> Fb;
 typedef CGAL::Triangulation_data_structure_2<Vb,Fb> Tds;
 typedef CGAL::Delaunay_triangulation_2<K,Tds> Triangulation;
 
@@ -17,96 +24,146 @@ typedef Triangulation::Face_handle FaceHandle;
 typedef Triangulation::Vertex_handle VertexHandle;
 typedef K::Point_2 Point;
 
+typedef CGAL::Spatial_sort_traits_adapter_2<K, CGAL::Pointer_property_map<Point>::type> SortTraits;
+
+// Walks from v over Delaunay edges to neighbours that are closer to q, until there is none. The last vertex is the
+// nearest one to q. Only reads the triangulation, so it can run in parallel
+VertexHandle walk_to_nearest(const Triangulation &t, VertexHandle v, const Point &q) {
+  while(true) {
+    VertexHandle closest = v;
+    Triangulation::Vertex_circulator w = t.incident_vertices(v), done = w;
+    do {
+      if(!t.is_infinite(w) && CGAL::has_smaller_distance_to_point(q, w->point(), closest->point())) closest = w;
+    } while(++w != done);
+
+    if(closest == v) return v;
+    v = closest;
+  }
+}
+
+// Largest squared edge length that a disk can squeeze through on its way from every face to the outside.
+// All infinite faces are the single face 0 (the outside), the finite faces are numbered 1..F-1 in info().
+// The dual edges are added in decreasing order (Kruskal, maximum spanning tree): the moment a component gets
+// connected to the outside, the current edge is the bottleneck of all its faces. The faces of every component
+// are kept as a linked list, so merging is O(1) and every face is assigned exactly once
+std::vector<double> escape_bottlenecks(const Triangulation &t, int faces) {
+  std::vector<std::tuple<double, int, int>> edges;
+  for(auto e = t.finite_edges_begin(); e != t.finite_edges_end(); ++e) {
+    const int a = e->first->info(), b = e->first->neighbor(e->second)->info();
+    if(a != b) edges.emplace_back(t.segment(e).squared_length(), a, b);
+  }
+  std::sort(edges.begin(), edges.end(), std::greater<std::tuple<double, int, int>>());
+
+  std::vector<double> escape(faces, 0);
+  escape[0] = std::numeric_limits<double>::max();
+
+  std::vector<int> parent(faces), head(faces), tail(faces), next(faces, -1);
+  for(int f = 0; f < faces; ++f) parent[f] = head[f] = tail[f] = f;
+  auto find = [&](int x) {
+    while(parent[x] != x) x = parent[x] = parent[parent[x]];
+    return x;
+  };
+
+  for(const auto &edge : edges) {
+    int a = find(std::get<1>(edge)), b = find(std::get<2>(edge));
+    if(a == b) continue;
+    if(b == 0) std::swap(a, b);
+
+    if(a == 0) {
+      // Component b escapes through this edge. The outside stays the root and doesn't need a list
+      for(int f = head[b]; f != -1; f = next[f]) escape[f] = std::get<0>(edge);
+    } else {
+      next[tail[a]] = head[b];
+      tail[a] = tail[b];
+    }
+    parent[b] = a;
+  }
+  return escape;
+}
+
 int main() {
   std::ios_base::sync_with_stdio(false);
-  
+
   while(true) {
     // ===== READ INPUT =====
-    int n, m; 
-    
+    int n, m;
+
     // Read infected people
     std::cin >> n;
     if(n == 0) { break; } // Terminate when "0" is read
-    
+
     std::vector<Point> infected_points; infected_points.reserve(n);
     for(int i = 0; i < n; ++i) {
       double x, y; std::cin >> x >> y;
       infected_points.push_back(Point(x, y));
     }
-    
+
     // Read query people
     std::cin >> m;
-    
+
     std::vector<Point> query_points; query_points.reserve(m);
     std::vector<double> query_distances; query_distances.reserve(m);
     for(int i = 0; i < m; ++i) {
       int x, y; std::cin >> x >> y;
       double d; std::cin >> d;
-      
+
       query_points.push_back(Point(x, y));
       query_distances.push_back(d);
     }
-    
+
     // ===== PREPROCESSING =====
     Triangulation t;
     t.insert(infected_points.begin(), infected_points.end());
-    
-    // Precompute the maximum distance for which a disk can escape for each face
-    std::priority_queue<std::pair<double, FaceHandle>> q;
-    
-    // Add all the infinite faces to the priority queue, as from them any disk can escape
-    for (Triangulation::All_faces_iterator f = t.all_faces_begin(); f != t.all_faces_end(); ++f) {
-      if(t.is_infinite(f)) {
-        q.emplace(std::numeric_limits<double>::max(), f);
+
+    std::string answers(m, 'n');
+    if(t.dimension() < 2) {
+      // All infected people on a line: nothing is enclosed, only the distance to the nearest one matters
+      for(int i = 0; i < m; ++i) {
+        const Point &p = query_points[i];
+        if(CGAL::squared_distance(t.nearest_vertex(p)->point(), p) >= query_distances[i]) answers[i] = 'y';
       }
-      
-      // Initialize all max distances to 0
-      f->info() = 0;
+      std::cout << answers << std::endl;
+      continue;
     }
-    
-    // Calculate the max distance for each face using a BFS over faces
-    while(!q.empty()) {
-      auto top = q.top(); q.pop();
-      auto distance = top.first;
-      auto face_handle = top.second;
-      
-      // We are visiting a face, that we have previously already visited with a "cheaper" distance. Therefore we can simply skip it
-      if(face_handle->info() >= distance) { continue; }
-  
-      // Set the maximum distance, that can escape from the current face
-      face_handle->info() = distance;
-      
-      // Go over to neighbors
-      for(int i = 0; i < 3; ++i) {
-        auto neighbor = face_handle->neighbor(i);
-        
-        // Skip neighbors that have already been visited
-        if(t.is_infinite(neighbor) || neighbor->info() != 0) { continue; }
-      
-        // Calculate the maximum distance that can pass to this neighbor
-        auto v1 = face_handle->vertex((i+1) % 3) -> point();
-        auto v2 = face_handle->vertex((i+2) % 3) -> point();
-          
-        double min_distance = std::min(CGAL::squared_distance(v1, v2), distance);
-        q.emplace(min_distance, neighbor);
-      }
+
+    // Dense face ids, all infinite faces are the outside (0)
+    int faces = 1;
+    for(auto f = t.all_faces_begin(); f != t.all_faces_end(); ++f) {
+      f->info() = t.is_infinite(f) ? 0 : faces++;
     }
-    
+    const std::vector<double> escape = escape_bottlenecks(t, faces);
+
     // ===== ANSWER QUERIES =====
+    // Locate the queries in spatial order, each walk starting at the previous face
+    std::vector<std::ptrdiff_t> order(m);
+    for(int i = 0; i < m; ++i) order[i] = i;
+    CGAL::spatial_sort(order.begin(), order.end(), SortTraits(CGAL::make_property_map(query_points)));
+
+    std::vector<FaceHandle> located(m);
+    FaceHandle hint;
     for(int i = 0; i < m; ++i) {
-      Point p = query_points[i];
-      double d = query_distances[i];
-      
-      FaceHandle face = t.locate(p);
-      VertexHandle vertex = t.nearest_vertex(p);
-      
-      if(CGAL::squared_distance(vertex->point(), p) < d) { std::cout << "n"; }
-      else {
-        if(face->info() >= 4 * d) { std::cout << "y"; }
-        else { std::cout << "n"; }
+      hint = located[order[i]] = t.locate(query_points[order[i]], hint);
+    }
+
+    // The nearest infected person is searched from a corner of the located face, and the queries are independent
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(static)
+    #endif
+    for(int j = 0; j < m; ++j) {
+      const int i = order[j];
+      const Point &p = query_points[i];
+      const double d = query_distances[i];
+
+      const FaceHandle face = located[i];
+      const VertexHandle corner = face->vertex(t.is_infinite(face->vertex(0)) ? 1 : 0);
+      const VertexHandle vertex = walk_to_nearest(t, corner, p);
+
+      // The person must not be infected right away and must be able to escape with a disk of radius sqrt(d)
+      if(CGAL::squared_distance(vertex->point(), p) >= d && escape[face->info()] >= 4 * d) {
+        answers[i] = 'y';
       }
     }
-    
-    std::cout << std::endl;
+
+    std::cout << answers << std::endl;
   }
-}
\ No newline at end of file
+}
@@ -1,74 +1,119 @@
 ///4
 #include<iostream>
 #include<vector>
+#include<queue>
+#include<limits>
+#include<tuple>
+#include<functional>
 
 #include<boost/graph/adjacency_list.hpp>
-#include<boost/graph/push_relabel_max_flow.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
 #include<boost/graph/max_cardinality_matching.hpp>
 
-using traits = boost::adjacency_list_traits<boost::vecS, boost::vecS, boost::directedS>;
 using graph = boost::adjacency_list<boost::vecS,
                                     boost::vecS,
-                                    boost::undirectedS,
-                                    boost::no_property,
-                                    boost::property<boost::edge_weight_t, int>>;
-using vertex_desc = traits::vertex_descriptor;
-using edge_desc = traits::edge_descriptor;
+                                    boost::undirectedS>;
 
+// Road network in CSR format (each road in both directions)
+struct Network {
+  std::vector<int> offsets, targets, lengths;
+
+  Network(int num_nodes, const std::vector<std::tuple<int, int, int>> &roads) : offsets(num_nodes + 1, 0) {
+    for(const auto &road : roads) {
+      offsets[std::get<0>(road) + 1]++;
+      offsets[std::get<1>(road) + 1]++;
+    }
+    for(int u = 0; u < num_nodes; ++u) offsets[u + 1] += offsets[u];
+
+    targets.resize(offsets[num_nodes]); lengths.resize(offsets[num_nodes]);
+    std::vector<int> pos(offsets.begin(), offsets.end() - 1);
+    for(const auto &road : roads) {
+      int x, y, l; std::tie(x, y, l) = road;
+      targets[pos[x]] = y; lengths[pos[x]++] = l;
+      targets[pos[y]] = x; lengths[pos[y]++] = l;
+    }
+  }
+};
+
+// Single Dijkstra started from all barracks at once, that stops as soon as the next node is further than d away.
+// Returns which nodes are within distance d of any barrack
+std::vector<bool> covered_nodes(const Network &network, const std::vector<int> &barracks, int d) {
+  const int num_nodes = network.offsets.size() - 1;
+  std::vector<int> dist(num_nodes, std::numeric_limits<int>::max());
+  std::vector<bool> covered(num_nodes, false);
+
+  std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<std::pair<int, int>>> queue;
+  for(const int barrack : barracks) {
+    dist[barrack] = 0;
+    queue.emplace(0, barrack);
+  }
+
+  while(!queue.empty()) {
+    const int u_dist = queue.top().first, u = queue.top().second; queue.pop();
+    if(u_dist > d) break;             // All remaining nodes are too far away
+    if(u_dist != dist[u]) continue;   // Outdated entry
+    covered[u] = true;
+
+    for(int e = network.offsets[u]; e < network.offsets[u + 1]; ++e) {
+      const int v = network.targets[e];
+      const long v_dist = (long) u_dist + network.lengths[e];
+
+      if(v_dist <= d && v_dist < dist[v]) {
+        dist[v] = v_dist;
+        queue.emplace(v_dist, v);
+      }
+    }
+  }
+
+  return covered;
+}
 
 void solve() {
   // ===== READ INPUT & BUILD GRAPH =====
   int n, m, b, p, d; std::cin >> n >> m >> b >> p >> d;
   int num_nodes = n + p;
-  
-  graph G(num_nodes);
+
   std::vector<int> barracks(b);
-  std::vector<int> plazas(p);
-  std::vector<bool> covered(num_nodes, false);
-  
+  std::vector<int> plaza_idx(n, -1); // Intersection -> index of its plaza (its duplicate is node n + index), -1 if it is no plaza
+
   for(int i = 0; i < b; ++i) std::cin >> barracks[i];
-  for(int i = 0; i < p; ++i) std::cin >> plazas[i];
+  for(int i = 0; i < p; ++i) {
+    int plaza; std::cin >> plaza;
+    plaza_idx[plaza] = i;
+  }
+
+  std::vector<std::tuple<int, int, int>> roads; roads.reserve(m + 2 * p);
   for(int i = 0; i < m; ++i) {
     int x, y, l; std::cin >> x >> y >> l;
-    boost::add_edge(x, y, l, G);
-    
-    // Duplicate plaza nodes
-    // Could be more efficient as we check this for every single edge
-    // But is fast enough
-    for(int j = 0; j < p; ++j) {
-      if(x == plazas[j]) {
-        boost::add_edge(y, n + j, l, G);
-      } else if (y == plazas[j]) {
-        boost::add_edge(x, n + j, l, G);
-      }
-    }
+    roads.emplace_back(x, y, l);
+
+    // Duplicate plaza nodes (a road between two plazas is duplicated for both of them)
+    if(plaza_idx[x] != -1) roads.emplace_back(y, n + plaza_idx[x], l);
+    if(plaza_idx[y] != -1) roads.emplace_back(x, n + plaza_idx[y], l);
   }
 
   // ===== FIND SUBGRAPH THAT IS COVERED BY BARRACKS =====
-  for(int i = 0; i < b; ++i) {
-    std::vector<int> dist_map(num_nodes); //exterior property
-    boost::dijkstra_shortest_paths(G, barracks[i], boost::distance_map(boost::make_iterator_property_map(dist_map.begin(), boost::get(boost::vertex_index, G))));
-  
-    for(int j = 0; j < num_nodes; ++j) {
-      if(dist_map[j] <= d) {
-        covered[j] = true;
-      }
-    }
-  }
+  const std::vector<bool> covered = covered_nodes(Network(num_nodes, roads), barracks, d);
 
+  // Only build the matching graph on the covered nodes (renumbered consecutively) and the roads between them
+  std::vector<int> new_idx(num_nodes, -1);
+  int num_covered = 0;
   for(int i = 0; i < num_nodes; ++i) {
-    if(!covered[i]) {
-      boost::clear_vertex(i, G);
-    }
+    if(covered[i]) new_idx[i] = num_covered++;
   }
 
+  std::vector<std::pair<int, int>> covered_roads;
+  for(const auto &road : roads) {
+    const int x = new_idx[std::get<0>(road)], y = new_idx[std::get<1>(road)];
+    if(x != -1 && y != -1) covered_roads.emplace_back(x, y);
+  }
+  graph G(covered_roads.begin(), covered_roads.end(), num_covered);
+
   // ===== FIND MAXIMUM MATCHING =====
-  std::vector<int> mate_map(num_nodes);
+  std::vector<int> mate_map(num_covered);
 
   boost::edmonds_maximum_cardinality_matching(G, boost::make_iterator_property_map(mate_map.begin(), boost::get(boost::vertex_index, G)));
   int matching_size = boost::matching_size(G, boost::make_iterator_property_map(mate_map.begin(), boost::get(boost::vertex_index, G)));
-  
+
   // ===== OUTPUT =====
   std::cout << matching_size << std::endl;
 }
@@ -78,4 +123,4 @@ int main() {
   while(n_tests--) {
     solve();
   }
-}
\ No newline at end of file
+}
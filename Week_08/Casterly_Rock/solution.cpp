@@ -16,14 +16,13 @@ typedef Solution::Variable_value_iterator SVI;
 // https://github.com/haeggee/algolab/blob/main/problems/week06-lannister/src/algorithm.cpp
 
 // Variables to easier reference the parameters of the line equation (and more)
+// The water canal is a2 * x + b2 * y + c2 = 0 with b2 = 1 and a2 = -b (orthogonality), so only c2 needs a variable
 const int a = 0;
 const int b = 1;
 const int c = 2;
 
-const int a2 = 3;
-const int b2 = 4;
-const int c2 = 5;
-const int d  = 6;
+const int c2 = 3;
+const int d  = 4;
 
 void solve() {
   // ===== READ INPUT =====
@@ -48,6 +47,11 @@ void solve() {
   
   Program lp(CGAL::SMALLER, false, 0, false, 0);
   
+  // Tywins constraint (sewer length) is b * sewer_b + c * sewer_c <= sewer_rhs, as a is fixed to 1
+  const long sewer_b = sum_y_commons - sum_y_nobles;
+  const long sewer_c = m - n;
+  const long sewer_rhs = s - sum_x_commons + sum_x_nobles;
+  
   // ===== FIRST LINEAR PROGRAM (CERSEI) =====
   if(true) {  // Always check Cerseis constraint
     // Check if noble and common houses are linearly sepearble such that the noble houses are on the left of the line
@@ -69,7 +73,13 @@ void solve() {
     // Add constraint, that the normal has to point to the left, to ensure that the noble houses are on the left
     lp.set_l(a, true, 1);
     lp.set_u(a, true, 1);
-    // No objective function needed, as we only want to check for feasibility/separability
+    
+    // Instead of only checking for feasibility, minimize the left hand side of Tywins constraint over all separating canals.
+    // The optimum of this solve already decides Tywins constraint, so it does not need a separate solve
+    if(s != -1) {
+      lp.set_c(b, sewer_b);
+      lp.set_c(c, sewer_c);
+    }
     
     // ===== SOLVE =====
     CGAL::Quadratic_program_options options;
@@ -79,19 +89,21 @@ void solve() {
       std::cout << "Y" << std::endl;
       return;
     }
-  }
-  
-  // ===== SECOND LINEAR PROGRAM (TYWIN) =====  
-  if(s != -1) {  // Only check for Tywins constraint if it is actually present (s != -1)
-    lp.set_a(b, m + n, sum_y_commons - sum_y_nobles);
-    lp.set_a(c, m + n, m - n);
-    lp.set_b(m + n, s - sum_x_commons + sum_x_nobles);
-
-    // ===== SOLVE =====
-    Solution solution = CGAL::solve_linear_program(lp, ET());
-    if(solution.is_infeasible()) {
-      std::cout << "B" << std::endl;
-      return;
+    
+    // ===== SECOND LINEAR PROGRAM (TYWIN) =====  
+    if(s != -1) {  // Only check for Tywins constraint if it is actually present (s != -1)
+      // Even the shortest sewer pipes among all separating canals exceed the budget
+      if(solution.is_optimal() && solution.objective_value() > CGAL::Quotient<ET>(ET(sewer_rhs))) {
+        std::cout << "B" << std::endl;
+        return;
+      }
+      
+      // Otherwise keep Tywins constraint for Jaimes LP and reset the objective
+      lp.set_a(b, m + n, sewer_b);
+      lp.set_a(c, m + n, sewer_c);
+      lp.set_b(m + n, sewer_rhs);
+      lp.set_c(b, 0);
+      lp.set_c(c, 0);
     }
   }
   
@@ -100,15 +112,16 @@ void solve() {
   // ===== THIRD LINEAR PROGRAM (JAIME) =====
   if(true) {  // Always optimize for Jamies requirement
     // Minimize the (vertical) distance between the all the houses and the water canal
+    // The water canal is y = b * x - c2, as a2 = -b and b2 = 1
     
     // Add noble houses constraints
     for(int i = 0; i < n; ++i) {
-      lp.set_a(a2, n_rows + i, noble_houses[i][0]);
+      lp.set_a(b, n_rows + i, -noble_houses[i][0]);
       lp.set_a(c2, n_rows + i, 1);
       lp.set_a(d, n_rows + i, -1);
       lp.set_b(n_rows + i, -noble_houses[i][1]);
       
-      lp.set_a(a2, n_rows + i + n, -noble_houses[i][0]);
+      lp.set_a(b, n_rows + i + n, noble_houses[i][0]);
       lp.set_a(c2, n_rows + i + n, -1);
       lp.set_a(d, n_rows + i + n, -1);
       lp.set_b(n_rows + i + n, noble_houses[i][1]);
@@ -116,29 +129,17 @@ void solve() {
     
     // Add common houses constraints
     for(int i = 0; i < m; ++i) {
-      lp.set_a(a2, n_rows + 2*n + i, common_houses[i][0]);
+      lp.set_a(b, n_rows + 2*n + i, -common_houses[i][0]);
       lp.set_a(c2, n_rows + 2*n + i, 1);
       lp.set_a(d, n_rows + 2*n + i, -1);
       lp.set_b(n_rows + 2*n + i, -common_houses[i][1]);
       
-      lp.set_a(a2, n_rows + 2*n + i + m, -common_houses[i][0]);
+      lp.set_a(b, n_rows + 2*n + i + m, common_houses[i][0]);
       lp.set_a(c2, n_rows + 2*n + i + m, -1);
       lp.set_a(d, n_rows + 2*n + i + m, -1);
       lp.set_b(n_rows + 2*n + i + m, common_houses[i][1]);
     }
     
-    n_rows += 2 * n + 2 * m;
-    
-    // Ensure pipes are orthogonal
-    lp.set_a(b, n_rows + 1, 1);
-    lp.set_a(a2, n_rows + 1, 1); // b1 + a2 <= 0
-    lp.set_a(b, n_rows + 2, -1);
-    lp.set_a(a2, n_rows + 2, -1); // -b1 - a2 <= 0
-    
-    // Fix b2 to 1
-    lp.set_l(b2, true, 1);
-    lp.set_u(b2, true, 1);
-    
     lp.set_l(d, true, 0);
     
     // Minimize the maximum distance d
@@ -161,4 +162,4 @@ int main() {
   while(n_tests--) {
     solve();
   }
-}
\ No newline at end of file
+}
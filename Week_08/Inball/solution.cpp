@@ -1,66 +1,94 @@
 #include <iostream>
 #include <vector>
+#include <cmath>
 
 #include <CGAL/QP_models.h>
 #include <CGAL/QP_functions.h>
 #include <CGAL/Gmpz.h>
 #include <CGAL/Gmpq.h>
 
-typedef CGAL::Gmpq IT;
-typedef CGAL::Gmpq ET;
+// Returns the square root of x if x is a perfect square and -1 otherwise
+long exact_sqrt(long x) {
+  long root = std::sqrt((double) x);
+  while(root * root > x) --root;
+  while((root + 1) * (root + 1) <= x) ++root;
+  return root * root == x ? root : -1;
+}
 
-typedef CGAL::Quadratic_program<IT> Program;
-typedef CGAL::Quadratic_program_solution<ET> Solution;
+// Builds and solves the Chebyshev center LP: max r  s.t.  a_i^T x + ||a_i|| r <= b_i,  r >= 0
+// Prints the largest integral radius, "none" if the polyhedron is empty and "inf" if it is unbounded
+template<typename IT, typename ET>
+void solve_inball(const std::vector<std::vector<long>> &A, const std::vector<long> &b, const std::vector<IT> &norms) {
+  typedef CGAL::Quadratic_program<IT> Program;
+  typedef CGAL::Quadratic_program_solution<ET> Solution;
+
+  const int n = A.size();
+  const int d = A[0].size();
+  const int r = d;
+
+  Program lp(CGAL::SMALLER, false, 0, false, 0);
+
+  for(int i = 0; i < n; ++i) {
+    for(int j = 0; j < d; ++j) {
+      lp.set_a(j, i, A[i][j]);
+    }
+
+    lp.set_a(r, i, norms[i]);
+    lp.set_b(i, b[i]);
+  }
+
+  lp.set_l(r, true, 0);
+  lp.set_c(r, -1); // Maximize r => Invert objective
+
+  // ===== SOLVE AND OUTPUT =====
+  Solution s = CGAL::solve_linear_program(lp, ET());
+
+  if(s.is_infeasible()) {
+    std::cout << "none" << std::endl;
+  } else if(s.is_unbounded()) {
+    std::cout << "inf" << std::endl;
+  } else {
+    std::cout << (long) CGAL::to_double(-s.objective_value()) << std::endl;
+  }
+}
 
 int main() {
   std::ios_base::sync_with_stdio(false);
-  
+
   while(true) {
     // ===== READ INPUT =====
     int n; std::cin >> n;
     if(n == 0) break;
     int d; std::cin >> d;
-    
-    std::vector<std::vector<IT>> A(n, std::vector<IT>(d));
-    std::vector<IT> norms(n);
-    std::vector<IT> b(n);
+
+    std::vector<std::vector<long>> A(n, std::vector<long>(d));
+    std::vector<long> b(n);
+    std::vector<long> squared_norms(n, 0);
     for(int i = 0; i < n; ++i) {
-      double norm = 0;
       for(int j = 0; j < d; ++j) {
         std::cin >> A[i][j];
-        norm += std::pow(CGAL::to_double(A[i][j]), 2);
+        squared_norms[i] += A[i][j] * A[i][j];
       }
       std::cin >> b[i];
-    
-      norms[i] = std::sqrt(norm);
     }
-    
-    // ===== CONSTRUCT LINEAR PROGRAM =====
-    const int r = d;
-    
-    Program lp(CGAL::SMALLER, false, 0, false, 0);
-    
-    for(int i = 0; i < n; ++i) {
-      for(int j = 0; j < d; ++j) {
-        lp.set_a(j, i, A[i][j]);
-      }
-      
-      lp.set_a(r, i, norms[i]);
-      lp.set_b(i, b[i]);
+
+    // ===== CONSTRUCT AND SOLVE LINEAR PROGRAM =====
+    // The norms are integral (as per the problem statement), so the whole LP has integer coefficients.
+    // This allows int input (floating point filtered pricing) and Gmpz instead of Gmpq as exact type
+    std::vector<int> norms(n);
+    bool integral = true;
+    for(int i = 0; i < n && integral; ++i) {
+      norms[i] = exact_sqrt(squared_norms[i]);
+      integral = norms[i] != -1;
     }
-    
-    lp.set_l(r, true, 0);
-    lp.set_c(r, -1); // Maximize r => Invert objective
-    
-    // ===== SOLVE AND OUTPUT =====
-    Solution s = CGAL::solve_linear_program(lp, ET());
-    
-    if(s.is_infeasible()) {
-      std::cout << "none" << std::endl;
-    } else if(s.is_unbounded()) {
-      std::cout << "inf" << std::endl;
+
+    if(integral) {
+      solve_inball<int, CGAL::Gmpz>(A, b, norms);
     } else {
-      std::cout << (long) CGAL::to_double(-s.objective_value()) << std::endl;
+      // Fall back to rounded norms with exact rational coefficients
+      std::vector<CGAL::Gmpq> rational_norms(n);
+      for(int i = 0; i < n; ++i) rational_norms[i] = std::sqrt((double) squared_norms[i]);
+      solve_inball<CGAL::Gmpq, CGAL::Gmpq>(A, b, rational_norms);
     }
   }
-}
\ No newline at end of file
+}
@@ -1,72 +1,185 @@
 #include<iostream>
-#include<cmath>
+#include<vector>
+#include<array>
 
-#include <CGAL/QP_models.h>
-#include <CGAL/QP_functions.h>
-#include <CGAL/Gmpz.h>
+// A 2D or 3D linear program  max c * x  s.t.  A x <= b0 + b1 * s,  where only the right hand side depends on the parameter s.
+// The constraint matrix is fixed, so all candidate vertices (as affine functions of s) and all extreme rays of the
+// recession cone can be precomputed once. A query then only evaluates these candidates exactly in integers
+class ParametricLP {
+public:
+  enum Status { OPTIMAL, INFEASIBLE, UNBOUNDED };
 
-typedef int IT;
-typedef CGAL::Gmpz ET;
-typedef CGAL::Quadratic_program<IT> Program;
-typedef CGAL::Quadratic_program_solution<ET> Solution;
-typedef Solution::Variable_value_iterator SVI;
+  ParametricLP(int d, const std::vector<std::array<long, 3>> &A, const std::vector<long> &b0, const std::vector<long> &b1)
+    : d(d), A(A), b0(b0), b1(b1) {
+    const int n = A.size();
 
-const int X = 0;
-const int Y = 1;
-const int Z = 2;
+    // Vertices: every set of d rows with a regular matrix M defines the point adj(M) * (b0 + b1 * s) / det(M)
+    for(int i = 0; i < n; ++i) {
+      for(int j = i + 1; j < n; ++j) {
+        if(d == 2) {
+          add_vertex({i, j, -1});
+        } else {
+          for(int k = j + 1; k < n; ++k) add_vertex({i, j, k});
+        }
+      }
+    }
+
+    // Extreme rays: directions that are tight for d - 1 rows and satisfy A r <= 0
+    for(int i = 0; i < n; ++i) {
+      if(d == 2) {
+        add_ray({-A[i][1], A[i][0], 0});
+      } else {
+        for(int j = i + 1; j < n; ++j) add_ray(cross(A[i], A[j]));
+      }
+    }
+  }
+
+  // Solves the LP for parameter s and objective c. If optimal, the optimal value is num / den (den > 0)
+  Status solve(long s, const std::array<long, 3> &c, long &num, long &den) const {
+    bool feasible = false;
+
+    for(const Vertex &v : vertices) {
+      std::array<long, 3> x;
+      for(int k = 0; k < d; ++k) x[k] = v.num0[k] + v.num1[k] * s;
+      if(!contains(x, v.det, s)) continue;
+
+      // Compare c * x / det with the best value so far
+      const long value = dot(c, x);
+      if(!feasible || value * den > num * v.det) {
+        num = value;
+        den = v.det;
+      }
+      feasible = true;
+    }
+
+    if(!feasible) return INFEASIBLE;
+    for(const auto &ray : rays) {
+      if(dot(c, ray) > 0) return UNBOUNDED;
+    }
+    return OPTIMAL;
+  }
+
+private:
+  struct Vertex {
+    std::array<long, 3> num0, num1;  // Coordinates are (num0 + num1 * s) / det
+    long det;                        // Always positive
+  };
+
+  int d;
+  std::vector<std::array<long, 3>> A;
+  std::vector<long> b0, b1;
+  std::vector<Vertex> vertices;
+  std::vector<std::array<long, 3>> rays;
+
+  long dot(const std::array<long, 3> &u, const std::array<long, 3> &v) const {
+    long result = 0;
+    for(int k = 0; k < d; ++k) result += u[k] * v[k];
+    return result;
+  }
+
+  static std::array<long, 3> cross(const std::array<long, 3> &u, const std::array<long, 3> &v) {
+    return { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+  }
+
+  // Checks A (x / det) <= b0 + b1 * s
+  bool contains(const std::array<long, 3> &x, long det, long s) const {
+    for(int i = 0; i < (int) A.size(); ++i) {
+      if(dot(A[i], x) > (b0[i] + b1[i] * s) * det) return false;
+    }
+    return true;
+  }
+
+  void add_vertex(const std::array<int, 3> &rows) {
+    // Adjugate and determinant of the d x d matrix formed by the rows
+    std::array<std::array<long, 3>, 3> adj = {};
+    long det;
+    if(d == 2) {
+      const auto &r0 = A[rows[0]], &r1 = A[rows[1]];
+      det = r0[0] * r1[1] - r0[1] * r1[0];
+      adj[0] = { r1[1], -r0[1], 0 };
+      adj[1] = { -r1[0], r0[0], 0 };
+    } else {
+      // The columns of the adjugate are the cross products of the other two rows
+      const auto &r0 = A[rows[0]], &r1 = A[rows[1]], &r2 = A[rows[2]];
+      const std::array<long, 3> c0 = cross(r1, r2), c1 = cross(r2, r0), c2 = cross(r0, r1);
+      det = dot(r0, c0);
+      for(int k = 0; k < 3; ++k) adj[k] = { c0[k], c1[k], c2[k] };
+    }
+    if(det == 0) return;
+
+    const long sign = det > 0 ? 1 : -1;
+    Vertex v = { {0, 0, 0}, {0, 0, 0}, sign * det };
+    for(int k = 0; k < d; ++k) {
+      for(int l = 0; l < d; ++l) {
+        v.num0[k] += sign * adj[k][l] * b0[rows[l]];
+        v.num1[k] += sign * adj[k][l] * b1[rows[l]];
+      }
+    }
+    vertices.push_back(v);
+  }
+
+  void add_ray(const std::array<long, 3> &r) {
+    if(r[0] == 0 && r[1] == 0 && r[2] == 0) return;
+
+    for(const long sign : {1, -1}) {
+      const std::array<long, 3> ray = { sign * r[0], sign * r[1], sign * r[2] };
+      bool in_cone = true;
+      for(const auto &row : A) in_cone = in_cone && dot(row, ray) <= 0;
+      if(in_cone) rays.push_back(ray);
+    }
+  }
+};
+
+// Rounds num / den (den > 0) down to the next integer
+long floor_div(long num, long den) {
+  return num >= 0 ? num / den : -((-num + den - 1) / den);
+}
 
 int main() {
   std::ios_base::sync_with_stdio(false);
+
+  // ===== PRECOMPUTE BOTH PROGRAMS (WITH s = a * b) =====
+  // p = 1: max b * y - a * x  s.t.  x, y >= 0,  x + y <= 4,  4x + 2y <= ab,  -x + y <= 1
+  const ParametricLP lp1(2, { {-1, 0, 0}, {0, -1, 0}, {1, 1, 0}, {4, 2, 0}, {-1, 1, 0} },
+                            { 0, 0, 4, 0, 1 },
+                            { 0, 0, 0, 1, 0 });
+
+  // p = 2: min a * x + b * y + z  s.t.  x, y, z <= 0,  x + y >= -4,  4x + 2y + z >= -ab,  -x + y >= -1
+  //        (solved as max -(a * x + b * y + z) with all constraints as <=)
+  const ParametricLP lp2(3, { {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {-1, -1, 0}, {-4, -2, -1}, {1, -1, 0} },
+                            { 0, 0, 0, 4, 0, 1 },
+                            { 0, 0, 0, 0, 1, 0 });
+
   while(true) {
     // ===== READ INPUT =====
     int p; std::cin >> p;
     if(p == 0) break;
-    
-    IT a, b; std::cin >> a >> b;
-    
+
+    long a, b; std::cin >> a >> b;
+
     // ===== SOLVE DEPENDING ON p =====
+    long num, den;
     if(p == 1) {
-      Program lp(CGAL::SMALLER, true, 0, false, 0);
-      
-      // Set constraints
-      lp.set_a(X, 0, 1); lp.set_a(Y, 0, 1); lp.set_b(0, 4);
-      lp.set_a(X, 1, 4); lp.set_a(Y, 1, 2); lp.set_b(1, a * b);
-      lp.set_a(X, 2, -1); lp.set_a(Y, 2, 1); lp.set_b(2, 1);
-      
-      // Set objective
-      lp.set_c(X, a); lp.set_c(Y, -b);
-      
-      // Solve
-      Solution s = CGAL::solve_linear_program(lp, ET());
-      
-      if(s.is_unbounded()) {
+      const ParametricLP::Status status = lp1.solve(a * b, {-a, b, 0}, num, den);
+
+      if(status == ParametricLP::UNBOUNDED) {
         std::cout << "unbounded" << std::endl;
-      } else if(s.is_infeasible()) {
+      } else if(status == ParametricLP::INFEASIBLE) {
         std::cout << "no" << std::endl;
       } else {
-        std::cout << (long)std::floor(-CGAL::to_double(s.objective_value())) << std::endl;
+        std::cout << floor_div(num, den) << std::endl;
       }
     } else {
-      Program lp(CGAL::LARGER, false, 0, true, 0);
-      
-      // Set constraints
-      lp.set_a(X, 0, 1); lp.set_a(Y, 0, 1); lp.set_b(0, -4);
-      lp.set_a(X, 1, 4); lp.set_a(Y, 1, 2); lp.set_a(Z, 1, 1); lp.set_b(1, -a * b);
-      lp.set_a(X, 2, -1); lp.set_a(Y, 2, 1); lp.set_b(2, -1);
-      
-      // Set objective
-      lp.set_c(X, a); lp.set_c(Y, b); lp.set_c(Z, 1);
-      
-      // Solve
-      Solution s = CGAL::solve_linear_program(lp, ET());
-      
-      if(s.is_infeasible()) {
+      const ParametricLP::Status status = lp2.solve(a * b, {-a, -b, -1}, num, den);
+
+      if(status == ParametricLP::INFEASIBLE) {
         std::cout << "no" << std::endl;
-      } else if(s.is_unbounded()) {
+      } else if(status == ParametricLP::UNBOUNDED) {
         std::cout << "unbounded" << std::endl;
       } else {
-        std::cout << (long)std::ceil(CGAL::to_double(s.objective_value())) << std::endl;
+        // The minimum is -num / den, rounded up
+        std::cout << -floor_div(num, den) << std::endl;
       }
     }
   }
-}
\ No newline at end of file
+}
@@ -1,79 +1,190 @@
 #include<iostream>
 #include<vector>
-#include<queue>
 #include<limits>
-#include<cmath>
+#include<tuple>
+#include<algorithm>
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/push_relabel_max_flow.hpp>
-#include <boost/tuple/tuple.hpp>
+// Hao-Orlin: the cheapest cut (S, T) of a directed graph over all T with the fixed source s in S, in the time of a
+// single push-relabel max flow. The nodes are moved into S one at a time, each phase uses the awake node with the
+// smallest label as sink and continues with the preflow of the previous phase. Nodes that can not reach the sink
+// anymore are put to sleep in dormant sets, which are woken up again (last one first) when all awake nodes are in S
+class HaoOrlin {
+public:
+  explicit HaoOrlin(int n) : n(n), adj(n) {}
 
-typedef  boost::adjacency_list_traits<boost::vecS, boost::vecS, boost::directedS> traits;
-typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, boost::no_property,
-  boost::property<boost::edge_capacity_t, long,
-    boost::property<boost::edge_residual_capacity_t, long,
-      boost::property<boost::edge_reverse_t, traits::edge_descriptor> > > >  graph;
-// Interior Property Maps
-typedef  boost::graph_traits<graph>::edge_descriptor      edge_desc;
-typedef  boost::graph_traits<graph>::out_edge_iterator      out_edge_it;
+  void add_edge(int from, int to, long capacity) {
+    adj[from].push_back({to, capacity, capacity, (int) adj[to].size()});
+    adj[to].push_back({from, 0, 0, (int) adj[from].size() - 1});
+  }
 
-class edge_adder {
- graph &G;
+  long min_cut(int s) {
+    excess.assign(n, 0); label.assign(n, 0); count.assign(2 * n + 1, 0);
+    in_source.assign(n, false); awake.assign(n, true); in_queue.assign(n, false);
+    dormant.clear();
 
- public:
-  explicit edge_adder(graph &G) : G(G) {}
+    in_source[s] = true; awake[s] = false;
+    count[0] = n - 1;
+    saturate(s);
 
-  void add_edge(int from, int to, long capacity) {
-    auto c_map = boost::get(boost::edge_capacity, G);
-    auto r_map = boost::get(boost::edge_reverse, G);
-    const edge_desc e = boost::add_edge(from, to, G).first;
-    const edge_desc rev_e = boost::add_edge(to, from, G).first;
-    c_map[e] = capacity;
-    c_map[rev_e] = 0; // reverse edge has no capacity!
-    r_map[e] = rev_e;
-    r_map[rev_e] = e;
+    long best = std::numeric_limits<long>::max();
+    for(int phase = 1; phase < n; ++phase) {
+      sink = -1;
+      for(int v = 0; v < n; ++v) {
+        if(awake[v] && (sink == -1 || label[v] < label[sink])) sink = v;
+      }
+
+      // Maximum preflow into the sink: discharge all other active awake nodes
+      for(int v = 0; v < n; ++v) activate(v);
+      while(!queue.empty()) {
+        const int v = queue.back(); queue.pop_back();
+        in_queue[v] = false;
+        discharge(v);
+      }
+
+      // The asleep nodes (S and the dormant sets) against the awake nodes are a min cut for this sink
+      long cut = 0;
+      for(int u = 0; u < n; ++u) {
+        if(awake[u]) continue;
+        for(const Arc &a : adj[u]) {
+          if(awake[a.to]) cut += a.capacity;
+        }
+      }
+      best = std::min(best, cut);
+
+      // The sink becomes a source
+      in_source[sink] = true; awake[sink] = false; count[label[sink]]--;
+      saturate(sink);
+      if(std::none_of(awake.begin(), awake.end(), [](bool a) { return a; }) && !dormant.empty()) {
+        for(const int v : dormant.back()) { awake[v] = true; count[label[v]]++; }
+        dormant.pop_back();
+      }
+    }
+    return best;
+  }
+
+private:
+  struct Arc {
+    int to;
+    long residual, capacity;
+    int reverse; // Index of the reverse arc in adj[to]
+  };
+
+  int n, sink;
+  std::vector<std::vector<Arc>> adj;
+  std::vector<long> excess;
+  std::vector<int> label, count; // count: number of awake nodes with every label
+  std::vector<bool> in_source, awake, in_queue;
+  std::vector<std::vector<int>> dormant;
+  std::vector<int> queue;
+
+  void activate(int v) {
+    if(awake[v] && v != sink && excess[v] > 0 && !in_queue[v]) {
+      in_queue[v] = true;
+      queue.push_back(v);
+    }
+  }
+
+  void push(int v, Arc &a, long delta) {
+    a.residual -= delta;
+    adj[a.to][a.reverse].residual += delta;
+    excess[v] -= delta;
+    excess[a.to] += delta;
+  }
+
+  // Pushes as much as possible out of the new source u, into everything that is not a source yet
+  void saturate(int u) {
+    for(Arc &a : adj[u]) {
+      if(a.residual > 0 && !in_source[a.to]) push(u, a, a.residual);
+    }
+  }
+
+  void discharge(int v) {
+    while(excess[v] > 0 && awake[v]) {
+      for(Arc &a : adj[v]) {
+        if(a.residual > 0 && awake[a.to] && label[v] == label[a.to] + 1) {
+          push(v, a, std::min(excess[v], a.residual));
+          activate(a.to);
+          if(excess[v] == 0) return;
+        }
+      }
+      relabel(v);
+    }
+  }
+
+  void relabel(int v) {
+    if(count[label[v]] == 1) {
+      // Gap: v and every awake node above it can not reach the sink anymore
+      std::vector<int> asleep;
+      for(int w = 0; w < n; ++w) {
+        if(awake[w] && label[w] >= label[v]) { awake[w] = false; count[label[w]]--; asleep.push_back(w); }
+      }
+      dormant.push_back(asleep);
+      return;
+    }
+
+    int lowest = std::numeric_limits<int>::max();
+    for(const Arc &a : adj[v]) {
+      if(a.residual > 0 && awake[a.to]) lowest = std::min(lowest, label[a.to]);
+    }
+
+    count[label[v]]--;
+    if(lowest == std::numeric_limits<int>::max()) {
+      // No residual arc to an awake node left, v goes to sleep on its own
+      awake[v] = false;
+      dormant.push_back({v});
+    } else {
+      label[v] = lowest + 1;
+      count[label[v]]++;
+    }
   }
 };
 
 void solve() {
   // ===== READ INPUT =====
   int n, m; std::cin >> n >> m;
-  
-  std::vector<std::vector<int>> adj_mat(n, std::vector<int>(n, 0));
+
+  std::vector<std::tuple<int, int, int>> limbs(m);
   for(int i = 0; i < m; ++i) {
     int a, b, c; std::cin >> a >> b >> c;
-    adj_mat[a][b] += c;
+    limbs[i] = std::make_tuple(a, b, c);
   }
-  
-  // ===== CONSTRUCT GRAPH =====
-  graph G(n);
-  edge_adder adder(G);
-
-  for(int i = 0; i < n; ++i) {
-    for(int j = 0; j < n; ++j) {
-      if(adj_mat[i][j]) {
-        adder.add_edge(i, j, adj_mat[i][j]);
-      }
+
+  // Merge parallel limbs by sorting them, instead of aggregating them in a n x n matrix
+  std::sort(limbs.begin(), limbs.end());
+  int n_merged = 0;
+  for(int i = 0; i < m; ++i) {
+    if(n_merged > 0 && std::get<0>(limbs[n_merged - 1]) == std::get<0>(limbs[i]) && std::get<1>(limbs[n_merged - 1]) == std::get<1>(limbs[i])) {
+      std::get<2>(limbs[n_merged - 1]) += std::get<2>(limbs[i]);
+    } else {
+      limbs[n_merged++] = limbs[i];
     }
   }
-  
+  limbs.resize(n_merged);
+
   // ====== CALCULATE MIN CUT =====
-  int min_cut = std::numeric_limits<int>::max();
-  
-  // Consider all other nodes as sinks and look for the min cut
-  for(int i = 0; i < n; ++i) {
-    min_cut = std::min(min_cut, (int) boost::push_relabel_max_flow(G, 0, i));
-    min_cut = std::min(min_cut, (int) boost::push_relabel_max_flow(G, i, 0));
+  // Either figure 0 is on the source side of the min cut, or it is on the sink side, which is the source side if all
+  // limbs are reversed. One Hao-Orlin run for each case, they are independent and can run in parallel
+  long min_cut[2];
+  #ifdef _OPENMP
+  #pragma omp parallel for
+  #endif
+  for(int reversed = 0; reversed < 2; ++reversed) {
+    HaoOrlin figures(n);
+    for(const auto &limb : limbs) {
+      const int a = std::get<0>(limb), b = std::get<1>(limb), c = std::get<2>(limb);
+      if(reversed) figures.add_edge(b, a, c); else figures.add_edge(a, b, c);
+    }
+    min_cut[reversed] = figures.min_cut(0);
   }
 
-  std::cout << min_cut << std::endl;
+  std::cout << std::min(min_cut[0], min_cut[1]) << std::endl;
 }
 
 int main() {
   std::ios_base::sync_with_stdio(false);
-  
+
   int n_tests; std::cin >> n_tests;
   while(n_tests--) {
     solve();
   }
-}
\ No newline at end of file
+}
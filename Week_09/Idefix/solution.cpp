@@ -1,11 +1,14 @@
 #include <iostream>
+#include <iomanip>
 #include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Delaunay_triangulation_2.h>
 #include <CGAL/Triangulation_vertex_base_with_info_2.h>
 #include <CGAL/Triangulation_face_base_2.h>
-#include <boost/pending/disjoint_sets.hpp>
 
 typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
 
@@ -15,123 +18,137 @@ typedef CGAL::Triangulation_face_base_2<K>                     Fb;
 typedef CGAL::Triangulation_data_structure_2<Vb,Fb>            Tds;
 typedef CGAL::Delaunay_triangulation_2<K,Tds>                  Delaunay;
 
-typedef std::tuple<Index,Index,K::FT> Edge;
-
 typedef K::Point_2 Point;
 typedef std::pair<Point,Index> IPoint;
 
-std::ostream& operator<<(std::ostream& o, const Edge& e) {
-  return o << std::get<0>(e) << " " << std::get<1>(e) << " " << std::get<2>(e);
-}
+// Edges of a graph as structure of arrays (endpoints u, v and squared length), sorted ascendingly by length.
+// Built from the Delaunay triangulation it contains the Euclidean minimum spanning tree, so Kruskal over these edges
+// yields the components for every distance threshold
+struct EdgeList {
+  std::vector<Index> u, v;
+  std::vector<double> length;
+
+  explicit EdgeList(const Delaunay &t) {
+    for(auto e = t.finite_edges_begin(); e != t.finite_edges_end(); ++e) {
+      add(e->first->vertex((e->second + 1) % 3)->info(), e->first->vertex((e->second + 2) % 3)->info(),
+          t.segment(e).squared_length());
+    }
+    sort();
+  }
+
+  int size() const { return length.size(); }
+
+  // Appends an edge, the list has to be sorted again afterwards
+  void add(Index a, Index b, double squared_length) {
+    u.push_back(a); v.push_back(b); length.push_back(squared_length);
+  }
+
+  // LSD radix sort on 16 bit digits. The bits of a non-negative double compare like the double itself
+  void sort() {
+    const int m = size();
+    std::vector<uint64_t> key(m), key_tmp(m);
+    std::vector<Index> u_tmp(m), v_tmp(m);
+    for(int i = 0; i < m; ++i) std::memcpy(&key[i], &length[i], sizeof(double));
+
+    std::vector<int> count(1 << 16);
+    for(int shift = 0; shift < 64 && m > 0; shift += 16) {
+      std::fill(count.begin(), count.end(), 0);
+      for(int i = 0; i < m; ++i) count[(key[i] >> shift) & 0xFFFF]++;
+      if(count[(key[0] >> shift) & 0xFFFF] == m) continue; // All keys share this digit
+
+      int sum = 0;
+      for(int &c : count) { const int c_old = c; c = sum; sum += c_old; }
+      for(int i = 0; i < m; ++i) {
+        const int pos = count[(key[i] >> shift) & 0xFFFF]++;
+        key_tmp[pos] = key[i]; u_tmp[pos] = u[i]; v_tmp[pos] = v[i];
+      }
+      key.swap(key_tmp); u.swap(u_tmp); v.swap(v_tmp);
+    }
+    for(int i = 0; i < m; ++i) std::memcpy(&length[i], &key[i], sizeof(double));
+  }
+};
+
+// Union-Find (union by weight, path halving) that keeps the total weight of every component
+struct Components {
+  std::vector<Index> parent;
+  std::vector<int> weight;
+
+  explicit Components(const std::vector<int> &weights) : parent(weights.size()), weight(weights) {
+    for(std::size_t i = 0; i < parent.size(); ++i) parent[i] = i;
+  }
+
+  Index find(Index x) {
+    while(parent[x] != x) x = parent[x] = parent[parent[x]];
+    return x;
+  }
+
+  // Merges the components with roots a != b, returns the new root
+  Index link(Index a, Index b) {
+    if(weight[a] < weight[b]) std::swap(a, b);
+    parent[b] = a;
+    weight[a] += weight[b];
+    return a;
+  }
+};
 
 void solve() {
   // ===== READ INPUT =====
   int n, m, k; long s; std::cin >> n >> m >> s >> k;
-  
+
   std::vector<IPoint> trees; trees.reserve(n);
   for(int i = 0; i < n; ++i) {
     int x, y; std::cin >> x >> y;
     trees.emplace_back(Point(x, y), i);
   }
-  
+
   std::vector<Point> bones; bones.reserve(m);
   for(int i = 0; i < m; ++i) {
     int x, y; std::cin >> x >> y;
     bones.emplace_back(x, y);
   }
-  
+
   // ===== SOLVE =====
   Delaunay t;
   t.insert(trees.begin(), trees.end());
-  
-  // === Calculate a ===
-  
-  // Calculate edges with their distances
-  std::vector<Edge> edges; edges.reserve(3*n);
-  for (auto e = t.finite_edges_begin(); e != t.finite_edges_end(); ++e) {
-    Index i1 = e->first->vertex((e->second+1)%3)->info();
-    Index i2 = e->first->vertex((e->second+2)%3)->info();
-    if(i1 > i2) { std::swap(i1, i2); }
-    
-    edges.emplace_back(i1, i2, t.segment(e).squared_length());
-  }
-  
-  // Determine (connected) components using Union Find
-  boost::disjoint_sets_with_storage<> uf(n);
-  for (auto e = edges.begin(); e != edges.end(); ++e) {
-    Index c1 = uf.find_set(std::get<0>(*e));
-    Index c2 = uf.find_set(std::get<1>(*e));
-    K::FT dist = std::get<2>(*e);
-
-    if (c1 != c2 && dist <= s) {
-      uf.link(c1, c2);
-    }
-  }
-  
-  // Find number of bones for radius given by s
-  std::vector<int> num_bones(n, 0);
-  for(const Point &bone : bones) {
-    auto vertex_handle = t.nearest_vertex(bone);
-    if(4 * CGAL::squared_distance(bone, vertex_handle->point()) > s) { continue; }
-     
-    Index component = uf.find_set(vertex_handle->info());
-    num_bones[component]++;
-  }
-  
-  // Find maximum number of bones among components
-  int max_num_bones = 0;
-  for(const int &n : num_bones) {
-    max_num_bones = std::max(max_num_bones, n);
-  }
-  
-  // === Calculate q ===
-  // Calculate q by adding the edges between bones and trees and stopping the UF as soon as k bones are reached in one component
-  std::vector<int> bones_per_component(n + m, 0);
+
+  // Trees are the nodes 0..n-1, bone i is the node n + i and connected to its nearest tree. A bone is in the shadow
+  // of a tree exactly when 4 times its squared distance is at most the squared radius, like two trees meet
+  EdgeList edges(t);
   for(int i = 0; i < m; ++i) {
-    // Find Edge for the bone i
     auto vertex_handle = t.nearest_vertex(bones[i]);
-    edges.emplace_back(n + i, vertex_handle->info(), 4 * CGAL::squared_distance(bones[i], vertex_handle->point()));
-    bones_per_component[n + i] = 1;
+    edges.add(n + i, vertex_handle->info(), 4 * CGAL::squared_distance(bones[i], vertex_handle->point()));
   }
-  
-  // Sort, now with the edges between bones and trees
-  std::sort(edges.begin(), edges.end(), [](const Edge& e1, const Edge& e2) -> bool {
-      return std::get<2>(e1) < std::get<2>(e2);
-  });
-  
-  // Determine (connected) components using Union Find
-  boost::disjoint_sets_with_storage<> bones_uf(n + m);
-  K::FT q;
-  for (auto e = edges.begin(); e != edges.end(); ++e) {
-    Index c1 = bones_uf.find_set(std::get<0>(*e));
-    Index c2 = bones_uf.find_set(std::get<1>(*e));
-    K::FT dist = std::get<2>(*e);
-
-    if (c1 != c2) {
-      bones_uf.link(c1, c2);
-      Index c3 = bones_uf.find_set(std::get<0>(*e));
-      
-      int total_bones = bones_per_component[c1] + bones_per_component[c2];
-      bones_per_component[c1] = 0;
-      bones_per_component[c2] = 0;
-      bones_per_component[c3] = total_bones;
-      
-      if(bones_per_component[c3] >= k) {
-        // Found radius at which k bones can be obtained
-        q = dist;
-        break;
-      }
-    }
+  edges.sort();
+
+  // Only bones count towards the size of a component
+  std::vector<int> weights(n + m, 0);
+  std::fill(weights.begin() + n, weights.end(), 1);
+  Components components(weights);
+
+  // One Kruskal pass answers both: a is the most bones in one component once all edges <= s are added,
+  // q is the edge that first brings k bones together. Every merge contains a tree, so lonely bones never count
+  int max_num_bones = 0, a = -1;
+  double q = -1;
+  for(int i = 0; i < edges.size() && (a == -1 || q == -1); ++i) {
+    if(a == -1 && edges.length[i] > s) a = max_num_bones;
+
+    const Index c1 = components.find(edges.u[i]), c2 = components.find(edges.v[i]);
+    if(c1 == c2) continue;
+
+    const int num_bones = components.weight[components.link(c1, c2)];
+    max_num_bones = std::max(max_num_bones, num_bones);
+    if(q == -1 && num_bones >= k) q = edges.length[i]; // Found radius at which k bones can be obtained
   }
-  
+  if(a == -1) a = max_num_bones; // All edges are within s
+
   // ===== OUTPUT =====
   std::cout << std::fixed << std::setprecision(0);
-  std::cout << max_num_bones << " " << q << std::endl;
+  std::cout << a << " " << q << std::endl;
 }
 
 int main() {
   std::ios_base::sync_with_stdio(false);
-  
+
   int n_tests; std::cin >> n_tests;
   while(n_tests--) { solve(); }
-}
\ No newline at end of file
+}
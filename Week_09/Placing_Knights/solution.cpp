@@ -1,128 +1,224 @@
 #include<iostream>
 #include<vector>
 #include<queue>
+#include<limits>
+#include<algorithm>
+#include<cstdlib>
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/push_relabel_max_flow.hpp>
-
-typedef boost::adjacency_list_traits<boost::vecS, boost::vecS, boost::directedS> traits;
-typedef boost::adjacency_list<boost::vecS, 
-                              boost::vecS, 
-                              boost::directedS, 
-                              boost::no_property,
-                              boost::property<boost::edge_capacity_t, long,
-                                              boost::property<boost::edge_residual_capacity_t, long,
-                                                              boost::property<boost::edge_reverse_t, traits::edge_descriptor>>>> graph;
-typedef traits::vertex_descriptor vertex_desc;
-typedef traits::edge_descriptor edge_desc;
-typedef boost::graph_traits<graph>::out_edge_iterator      out_edge_it;
-
-// Create a vector containing all possible moves for a knight
-std::vector<std::pair<int, int>> OFFSETS = {
-    {-1, -2}, {-1, 2}, {1, -2}, {1, 2},
-    {-2, -1}, {-2, 1}, {2, -1}, {2, 1}
-};
+// Maximum bipartite matching (Hopcroft-Karp) on the implicit graph of a grid: cells with (r + c) even form the left side,
+// cells with (r + c) odd the right side and every free cell is connected to the free cells at the given offsets.
+// No explicit graph is built. The grid is padded with a border of blocked cells, so the neighbours of a cell
+// are just fixed index deltas without any bounds checks
+class GridMatching {
+public:
+  GridMatching(int h, int w, const std::vector<char> &free, const std::vector<std::pair<int, int>> &offsets) {
+    pad = 0;
+    for(const auto &offset : offsets) pad = std::max({pad, std::abs(offset.first), std::abs(offset.second)});
+    width = w + 2 * pad;
+
+    const int size = (h + 2 * pad) * width;
+    padded.assign(size, false); mate.assign(size, -1); dist.resize(size); next.resize(size);
+    for(const auto &offset : offsets) deltas.push_back(offset.first * width + offset.second);
 
-class edge_adder {
-  graph &G;
-  public:
-    explicit edge_adder(graph &G) : G(G) {}
-    void add_edge(int from, int to, long capacity) {
-      auto c_map = boost::get(boost::edge_capacity, G);
-      auto r_map = boost::get(boost::edge_reverse, G);
-      const auto e = boost::add_edge(from, to, G).first;
-      const auto rev_e = boost::add_edge(to, from, G).first;
-      c_map[e] = capacity;
-      c_map[rev_e] = 0; // reverse edge has no capacity!
-      r_map[e] = rev_e;
-      r_map[rev_e] = e;
+    for(int r = 0; r < h; ++r) {
+      for(int c = 0; c < w; ++c) {
+        const int u = (r + pad) * width + c + pad;
+        padded[u] = free[r * w + c];
+        if(padded[u] && (r + c) % 2 == 0) left.push_back(u);
+      }
     }
-};
+  }
 
-int get_index(int row, int col, int n) {
-  return row * n + col;
-}
+  // Size of a maximum matching
+  int max_matching() {
+    int matching = initial_matching();
 
-void solve() {
-  // ===== READ INPUT =====
-  int n; std::cin >> n;
-  
-  std::vector<std::vector<int>> board(n, std::vector<int>(n));
-  for(int row = 0; row < n; ++row) {
-    for(int col = 0; col < n; ++col) {
-      std::cin >> board[row][col];
+    while(bfs()) {
+      for(const int u : left) {
+        if(mate[u] == -1 && dfs(u)) matching++;
+      }
     }
+    return matching;
   }
-  
-  // ===== BUILD GRAPH =====
-  // Add all nodes, even if there are holes to make indexing easier
-  // We can just not connect the "hole nodes" to any other nodes
-  graph G(n * n); 
-  edge_adder adder(G);
-  auto rc_map = boost::get(boost::edge_residual_capacity, G);
-  
-  const vertex_desc v_source = boost::add_vertex(G);
-  const vertex_desc v_sink = boost::add_vertex(G);
-  
-  for(int row = 0; row < n; ++row) {
-    for(int col = 0; col < n; ++col) {
-      if(board[row][col] == 0) continue;
-      int idx = get_index(row, col, n);
 
-      // Connect to source or sink
-      if((row + col) % 2 == 0) {
-        adder.add_edge(v_source, idx, 1);
+  // Koenig's theorem: after the last phase, the alternating BFS layers (the cells reachable from unmatched left cells)
+  // give a minimum vertex cover as the unreachable left cells and the reachable right cells. A matched right cell is
+  // reachable exactly if its partner is. Only valid after max_matching()
+  bool in_cover(int r, int c) const {
+    const int u = (r + pad) * width + c + pad;
+    if(!padded[u]) return false;
+    if((r + c) % 2 == 0) return dist[u] == INF;
+    return mate[u] != -1 && dist[mate[u]] != INF;
+  }
+
+private:
+  static const int INF = std::numeric_limits<int>::max();
+
+  int pad;                           // Border width of the padded grid
+  int width;                         // Width of the padded grid
+  std::vector<char> padded;          // Free cells of the padded grid
+  std::vector<int> deltas;           // Index differences to the neighbours
+  std::vector<int> left;             // All free left cells
+  std::vector<int> mate;             // Matched partner of every cell (-1 if unmatched)
+  std::vector<int> dist;             // BFS layer of the left cells
+  std::vector<int> next;             // Next neighbour to try in the DFS (kept for the whole phase)
+
+  // Returns the neighbour k of cell u if it is free, -1 otherwise
+  int neighbour(int u, int k) const {
+    const int v = u + deltas[k];
+    return padded[v] ? v : -1;
+  }
+
+  // Returns the first unmatched free neighbour of cell u, -1 if there is none
+  int unmatched_neighbour(int u) const {
+    for(int k = 0; k < (int) deltas.size(); ++k) {
+      const int v = neighbour(u, k);
+      if(v != -1 && mate[v] == -1) return v;
+    }
+    return -1;
+  }
+
+  // Karp-Sipser heuristic: a cell with a single unmatched neighbour left can always be matched to it,
+  // otherwise an arbitrary edge is taken. On grids this leaves very few cells for the augmenting phases
+  int initial_matching() {
+    std::vector<int> degree(padded.size(), 0);
+    std::vector<int> forced;
+    for(int u = 0; u < (int) padded.size(); ++u) {
+      if(!padded[u]) continue;
+      for(int k = 0; k < (int) deltas.size(); ++k) degree[u] += neighbour(u, k) != -1;
+      if(degree[u] == 1) forced.push_back(u);
+    }
+
+    int matching = 0;
+    auto match = [&](int u, int v) {
+      mate[u] = v; mate[v] = u; matching++;
+      for(const int x : {u, v}) {
+        for(int k = 0; k < (int) deltas.size(); ++k) {
+          const int y = neighbour(x, k);
+          if(y != -1 && mate[y] == -1 && --degree[y] == 1) forced.push_back(y);
+        }
+      }
+    };
+
+    size_t scan = 0;
+    while(true) {
+      while(!forced.empty()) {
+        const int u = forced.back(); forced.pop_back();
+        if(mate[u] != -1) continue;
+        const int v = unmatched_neighbour(u);
+        if(v != -1) match(u, v);
+      }
+
+      // No forced cell left, take the next free edge
+      while(scan < left.size()) {
+        const int u = left[scan++];
+        const int v = mate[u] == -1 ? unmatched_neighbour(u) : -1;
+        if(v != -1) {
+          match(u, v);
+          break;
+        }
+      }
+      if(forced.empty() && scan == left.size()) break;
+    }
+    return matching;
+  }
+
+  // Layers the left cells by alternating path length from the unmatched ones, up to the layer of the shortest
+  // augmenting paths. Returns if an augmenting path exists
+  bool bfs() {
+    std::queue<int> queue;
+    for(const int u : left) {
+      next[u] = 0;
+      dist[u] = mate[u] == -1 ? 0 : INF;
+      if(mate[u] == -1) queue.push(u);
+    }
+
+    int limit = INF;
+    while(!queue.empty()) {
+      const int u = queue.front(); queue.pop();
+      if(dist[u] >= limit) break;
+
+      for(int k = 0; k < (int) deltas.size(); ++k) {
+        const int v = neighbour(u, k);
+        if(v == -1) continue;
+
+        const int x = mate[v];
+        if(x == -1) {
+          limit = dist[u] + 1;
+        } else if(dist[x] == INF) {
+          dist[x] = dist[u] + 1;
+          queue.push(x);
+        }
       }
-      else { 
-        adder.add_edge(idx, v_sink, 1);
+    }
+    return limit != INF;
+  }
+
+  // Iterative DFS along the BFS layers from the unmatched left cell root. Augments the matching if a path is found.
+  // Neighbours that were already tried in this phase are never tried again
+  bool dfs(int root) {
+    std::vector<int> stack = {root};
+
+    while(!stack.empty()) {
+      const int u = stack.back();
+      if(next[u] == (int) deltas.size()) {
+        // Dead end, never visit u again in this phase
+        dist[u] = INF;
+        stack.pop_back();
+        if(!stack.empty()) next[stack.back()]++;
         continue;
       }
-      
-      // Connect to nodes reachable by knight
-      for(const std::pair<int, int> &offset : OFFSETS) {
-        int adjusted_row = row + offset.first;
-        int adjusted_col = col + offset.second;
-        
-        if((adjusted_row < 0 || adjusted_row >= n) ||  // Row out of bounds
-           (adjusted_col < 0 || adjusted_col >= n) ||  // Col out of bounds
-           (board[adjusted_row][adjusted_col] == 0)    // Space is a hole
-           ){
-          continue;
+
+      const int v = neighbour(u, next[u]);
+      if(v == -1) {
+        next[u]++;
+      } else if(mate[v] == -1) {
+        // Augmenting path found, flip all edges along the stack
+        for(const int x : stack) {
+          const int y = neighbour(x, next[x]);
+          mate[x] = y;
+          mate[y] = x;
         }
-        adder.add_edge(idx, get_index(adjusted_row, adjusted_col, n), 1);
+        return true;
+      } else if(dist[mate[v]] == dist[u] + 1) {
+        stack.push_back(mate[v]);
+      } else {
+        next[u]++;
       }
     }
+    return false;
   }
+};
+
+void solve() {
+  // ===== READ INPUT =====
+  int n; std::cin >> n;
   
-  // ===== COMPUTE MAX FLOW AND SET S =====
-  boost::push_relabel_max_flow(G, v_source, v_sink);
-  
-  std::vector<int> vis(n * n + 2, false); // visited flags
-  std::queue<int> Q; // BFS queue (from std:: not boost::)
-  vis[v_source] = true; // Mark the source as visited
-  Q.push(v_source);
-  while (!Q.empty()) {
-    const int u = Q.front();
-    Q.pop();
-    out_edge_it ebeg, eend;
-    for (boost::tie(ebeg, eend) = boost::out_edges(u, G); ebeg != eend; ++ebeg) {
-      const int v = boost::target(*ebeg, G);
-      // Only follow edges with spare capacity
-      if (rc_map[*ebeg] == 0 || vis[v]) continue;
-      vis[v] = true;
-      Q.push(v);
+  std::vector<char> board(n * n);
+  for(int row = 0; row < n; ++row) {
+    for(int col = 0; col < n; ++col) {
+      int present; std::cin >> present;
+      board[row * n + col] = present;
     }
   }
   
+  // ===== COMPUTE MAXIMUM MATCHING AND MINIMUM VERTEX COVER =====
+  // Knights always jump between differently colored squares, so the board is bipartite.
+  // The squares are only connected implicitly through the knight moves, no graph is built
+  const std::vector<std::pair<int, int>> offsets = {
+    {-1, -2}, {-1, 2}, {1, -2}, {1, 2},
+    {-2, -1}, {-2, 1}, {2, -1}, {2, 1}
+  };
+  GridMatching matching(n, n, board, offsets);
+  matching.max_matching();
+  
   // ===== COUNT SIZE OF INDEPENDENT SET =====
+  // The complement of a minimum vertex cover is a maximum independent set
   int count = 0;
   for(int row = 0; row < n; ++row) {
     for(int col = 0; col < n; col++) {
-      if(board[row][col] == 0) continue;
-      int idx = get_index(row, col, n);
-      
-      if((row + col) % 2 == 0) count += vis[idx];
-      else count += 1 - vis[idx];
+      if(board[row * n + col] == 0) continue;
+      count += !matching.in_cover(row, col);
     }
   }
   
@@ -1,111 +1,293 @@
 #include<iostream>
 #include<vector>
+#include<array>
+#include<limits>
+#include<tuple>
+#include<cstdint>
+#include<algorithm>
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/cycle_canceling.hpp>
-#include <boost/graph/push_relabel_max_flow.hpp>
-#include <boost/graph/successive_shortest_path_nonnegative_weights.hpp>
-#include <boost/graph/find_flow_cost.hpp>
-
-typedef boost::adjacency_list_traits<boost::vecS, boost::vecS, boost::directedS> traits;
-typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, boost::no_property,
-    boost::property<boost::edge_capacity_t, long,
-        boost::property<boost::edge_residual_capacity_t, long,
-            boost::property<boost::edge_reverse_t, traits::edge_descriptor,
-                boost::property <boost::edge_weight_t, long> > > > > graph; // new! weightmap corresponds to costs
-
-typedef traits::vertex_descriptor vertex_desc;
-typedef boost::graph_traits<graph>::edge_descriptor edge_desc;
-typedef boost::graph_traits<graph>::out_edge_iterator out_edge_it; // Iterator
-
-class edge_adder {
- graph &G;
-
- public:
-  explicit edge_adder(graph &G) : G(G) {}
-  void add_edge(int from, int to, long capacity, long cost) {
-    auto c_map = boost::get(boost::edge_capacity, G);
-    auto r_map = boost::get(boost::edge_reverse, G);
-    auto w_map = boost::get(boost::edge_weight, G); // new!
-    const edge_desc e = boost::add_edge(from, to, G).first;
-    const edge_desc rev_e = boost::add_edge(to, from, G).first;
-    c_map[e] = capacity;
-    c_map[rev_e] = 0; // reverse edge has no capacity!
-    r_map[e] = rev_e;
-    r_map[rev_e] = e;
-    w_map[e] = cost;   // new assign cost
-    w_map[rev_e] = -cost;   // new negative cost
+// Monotone priority queue for Dijkstra (radix heap). Keys are bucketed by the highest bit in which they differ
+// from the last extracted key, so push is O(1) and pop is amortized O(log C)
+class RadixHeap {
+public:
+  bool empty() const { return size == 0; }
+
+  void push(uint64_t key, int value) {
+    buckets[bucket_of(key)].emplace_back(key, value);
+    size++;
+  }
+
+  std::pair<uint64_t, int> pop() {
+    if(buckets[0].empty()) {
+      // Redistribute the first non-empty bucket around its minimum
+      int i = 1;
+      while(buckets[i].empty()) ++i;
+
+      last = buckets[i][0].first;
+      for(const auto &entry : buckets[i]) last = std::min(last, entry.first);
+      for(const auto &entry : buckets[i]) buckets[bucket_of(entry.first)].push_back(entry);
+      buckets[i].clear();
+    }
+
+    const std::pair<uint64_t, int> top = buckets[0].back();
+    buckets[0].pop_back();
+    size--;
+    return top;
+  }
+
+  void clear() {
+    for(auto &bucket : buckets) bucket.clear();
+    last = 0;
+    size = 0;
+  }
+
+private:
+  std::array<std::vector<std::pair<uint64_t, int>>, 65> buckets;
+  uint64_t last = 0;
+  size_t size = 0;
+
+  int bucket_of(uint64_t key) const {
+    return key == last ? 0 : 64 - __builtin_clzll(key ^ last);
+  }
+};
+
+// Min cost assignment of buyers to sites, where every site lies in a state that can only sell a limited number of sites.
+// This is the flow network  source -> buyers -> sites -> states -> sink,  solved with the Hungarian method directly
+// on the dense, row-major cost matrix: buyers are added one at a time and each one is routed along a shortest
+// augmenting path (Dijkstra with potentials, so all reduced costs stay non-negative). No graph is built.
+//
+// To maximize the number of assigned buyers first, every buyer can also go directly to the sink ("unassigned")
+// at a penalty that is larger than any difference in assignment cost
+class StateAssignment {
+public:
+  StateAssignment(int N, int M, const std::vector<int> &costs, const std::vector<int> &site_state, const std::vector<int> &limits)
+    : N(N), M(M), S(limits.size()), costs(costs), site_state(site_state), limits(limits),
+      state_sites(S), owner(M, -1), site_of(N, -1), used(S, 0),
+      unassigned_penalty(100L * (N + M + 1)), pot_b(N, 0), pot_p(M, 0), pot_s(S, 0), pot_t(0) {
+    for(int j = 0; j < M; ++j) state_sites[site_state[j]].push_back(j);
+  }
+
+  // Assigns all buyers. Afterwards site_of[i] is the site of buyer i (-1 if buyer i gets none)
+  void solve() {
+    // Greedy start (as in Jonker-Volgenant): with the potential of every buyer set to minus its cheapest cost, all
+    // cheapest edges are tight. Any buyer can take such a site if it is still free and its state can still sell,
+    // the partial assignment stays optimal and only the remaining buyers have to be augmented
+    for(int i = 0; i < N; ++i) {
+      const int *row_costs = &costs[(long) i * M];
+      const int cheapest = *std::min_element(row_costs, row_costs + M);
+      pot_b[i] = -cheapest;
+
+      for(int j = 0; j < M; ++j) {
+        const int s = site_state[j];
+        if(row_costs[j] == cheapest && owner[j] == -1 && used[s] < limits[s]) {
+          owner[j] = i; site_of[i] = j; used[s]++;
+          break;
+        }
+      }
+    }
+
+    for(int i = 0; i < N; ++i) {
+      if(site_of[i] == -1) augment(i);
+    }
+  }
+
+  int assigned() const {
+    int count = 0;
+    for(int i = 0; i < N; ++i) count += site_of[i] != -1;
+    return count;
+  }
+
+  long cost() const {
+    long total = 0;
+    for(int i = 0; i < N; ++i) {
+      if(site_of[i] != -1) total += costs[(long) i * M + site_of[i]];
+    }
+    return total;
+  }
+
+private:
+  static constexpr long INF = std::numeric_limits<long>::max();
+
+  const int N, M, S;
+  const std::vector<int> &costs;             // N x M, row-major
+  const std::vector<int> &site_state;
+  const std::vector<int> &limits;
+  std::vector<std::vector<int>> state_sites;
+
+  // Current assignment
+  std::vector<int> owner;                    // Buyer of every site (-1 if unsold)
+  std::vector<int> site_of;                  // Site of every buyer (-1 if none)
+  std::vector<int> used;                     // Number of sold sites per state
+  const long unassigned_penalty;
+
+  // Potentials of buyers, sites, states and the sink
+  std::vector<long> pot_b, pot_p, pot_s;
+  long pot_t;
+
+  // Dijkstra state, only valid during augment()
+  std::vector<long> dist_b, dist_p, dist_s;
+  std::vector<char> done_b, done_p, done_s;
+  std::vector<int> from_p;                   // Site reached from buyer (>= 0) or from state s (-(s + 1))
+  std::vector<int> from_s;                   // State reached from site
+  RadixHeap heap;
+
+  // Routes buyer start along a shortest augmenting path
+  void augment(int start) {
+    dist_b.assign(N, INF); dist_p.assign(M, INF); dist_s.assign(S, INF);
+    done_b.assign(N, false); done_p.assign(M, false); done_s.assign(S, false);
+    from_p.assign(M, -1); from_s.assign(S, -1);
+
+    // Nodes in the heap: site j, buyer M + i, state M + N + s and the sink M + N + S
+    const int sink = M + N + S;
+    long dist_t = INF; int from_t = -1; // Sink reached from state s (>= 0) or from buyer i, that gets unassigned (-(i + 1))
+    heap.clear();
+
+    dist_b[start] = 0;
+    heap.push(0, M + start);
+
+    while(!heap.empty()) {
+      uint64_t key; int v; std::tie(key, v) = heap.pop();
+      const long d = key;
+
+      if(v < M) {
+        // Site j: backwards along the assignment to its buyer, or forward into its state if unsold
+        const int j = v;
+        if(done_p[j] || d != dist_p[j]) continue;
+        done_p[j] = true;
+
+        if(owner[j] != -1) {
+          const int i = owner[j];
+          const long di = d - costs[(long) i * M + j] + pot_p[j] - pot_b[i];
+          if(!done_b[i] && di < dist_b[i]) { dist_b[i] = di; heap.push(di, M + i); }
+        } else {
+          const int s = site_state[j];
+          const long ds = d + pot_p[j] - pot_s[s];
+          if(!done_s[s] && ds < dist_s[s]) { dist_s[s] = ds; from_s[s] = j; heap.push(ds, M + N + s); }
+        }
+      } else if(v < M + N) {
+        // Buyer i: relax the whole (contiguous) row of bids, or leave i without a site
+        const int i = v - M;
+        if(done_b[i] || d != dist_b[i]) continue;
+        done_b[i] = true;
+
+        const int *row_costs = &costs[(long) i * M];
+        const long base = d + pot_b[i];
+        for(int j = 0; j < M; ++j) {
+          const long dj = base + row_costs[j] - pot_p[j];
+          if(dj < dist_p[j] && !done_p[j] && owner[j] != i) {
+            dist_p[j] = dj; from_p[j] = i;
+            heap.push(dj, j);
+          }
+        }
+
+        const long dt = base + unassigned_penalty - pot_t;
+        if(dt < dist_t) { dist_t = dt; from_t = -(i + 1); heap.push(dt, sink); }
+      } else if(v < sink) {
+        // State s: into the sink if it can still sell, or backwards to its sold sites
+        const int s = v - M - N;
+        if(done_s[s] || d != dist_s[s]) continue;
+        done_s[s] = true;
+
+        if(used[s] < limits[s]) {
+          const long dt = d + pot_s[s] - pot_t;
+          if(dt < dist_t) { dist_t = dt; from_t = s; heap.push(dt, sink); }
+        }
+
+        for(const int j : state_sites[s]) {
+          if(owner[j] == -1 || done_p[j]) continue;
+          const long dj = d + pot_s[s] - pot_p[j];
+          if(dj < dist_p[j]) { dist_p[j] = dj; from_p[j] = -(s + 1); heap.push(dj, j); }
+        }
+      } else if(d == dist_t) {
+        // Shortest augmenting path found
+        update_potentials(d, dist_t);
+        flip_path(start, from_t);
+        return;
+      }
+    }
+  }
+
+  // Keeps all reduced costs non-negative: every node moves by its distance, capped at the distance D of the sink
+  void update_potentials(long D, long dist_t) {
+    for(int i = 0; i < N; ++i) pot_b[i] += std::min(dist_b[i], D);
+    for(int j = 0; j < M; ++j) pot_p[j] += std::min(dist_p[j], D);
+    for(int s = 0; s < S; ++s) pot_s[s] += std::min(dist_s[s], D);
+    pot_t += std::min(dist_t, D);
+  }
+
+  // Walks the augmenting path backwards from the sink and updates the assignment
+  void flip_path(int start, int from_t) {
+    int j;
+    if(from_t >= 0) {
+      used[from_t]++;
+      j = from_s[from_t];
+    } else {
+      // Buyer i gives up its site (if any)
+      const int i = -from_t - 1;
+      j = site_of[i];
+      if(j != -1) owner[j] = -1;
+      site_of[i] = -1;
+      if(i == start) return;
+    }
+
+    while(true) {
+      if(from_p[j] >= 0) {
+        // Site j is bought by buyer i, who gives up its previous site (if any)
+        const int i = from_p[j];
+        const int previous = site_of[i];
+        owner[j] = i;
+        site_of[i] = j;
+        if(i == start) return;
+        j = previous;
+      } else {
+        // Site j is no longer sold, another site k of the same state is sold instead
+        const int state = -from_p[j] - 1;
+        owner[j] = -1;
+        j = from_s[state];
+      }
+    }
   }
 };
 
 void solve() {
   // ===== READ INPUT =====
   int N, M, S; std::cin >> N >> M >> S;
-  
+
   std::vector<int> limits(S);
   for(int i = 0; i < S; ++i) {
     std::cin >> limits[i];
   }
-  
+
   std::vector<int> property_to_state(M);
   for(int i = 0; i < M; ++i) {
     std::cin >> property_to_state[i];
+    property_to_state[i]--;
   }
-  
-  std::vector<std::vector<int>> bids(N, std::vector<int>(M));
+
+  // Costs 100 - bid (so all are non-negative), stored contiguously in row-major order
+  std::vector<int> costs((long) N * M);
   for(int i = 0; i < N; ++i) {
     for(int j = 0; j < M; ++j) {
-      std::cin >> bids[i][j];
-    }
-  }
-  
-  // ===== BUILD GRAPH =====
-  graph G(N + M + S);
-  edge_adder adder(G);
-  auto c_map = boost::get(boost::edge_capacity, G);
-  auto r_map = boost::get(boost::edge_reverse, G);
-  auto rc_map = boost::get(boost::edge_residual_capacity, G);
-  
-  // Add Source and Sink
-  const vertex_desc v_source = boost::add_vertex(G);
-  const vertex_desc v_sink = boost::add_vertex(G);
-  
-  // Connect Source to Bidders and Bidders to Sites
-  for(int i = 0; i < N; ++i) {
-    adder.add_edge(v_source, i, 1, 0);
-    
-    for(int j = 0; j < M; j++) {
-      adder.add_edge(i, N + j, 1, 100 - bids[i][j]);
+      int bid; std::cin >> bid;
+      costs[(long) i * M + j] = 100 - bid;
     }
   }
-  
-  // Connect Sites to States
-  for(int i = 0; i < M; ++i) {
-    adder.add_edge(N + i, N + M + property_to_state[i] - 1, 1, 0);
-  }
-  
-  // Connect States to Sink
-  for(int i = 0; i < S; ++i) {
-    adder.add_edge(N + M + i, v_sink, limits[i], 0);
-  }
 
-  // ====== CALCULATE FLOW AND COST =====
-  boost::successive_shortest_path_nonnegative_weights(G, v_source, v_sink);
-  int cost = boost::find_flow_cost(G);
+  // ====== CALCULATE ASSIGNMENT AND COST =====
+  StateAssignment assignment(N, M, costs, property_to_state, limits);
+  assignment.solve();
 
-  int sold = 0;
-  out_edge_it e, eend;
-  for(boost::tie(e, eend) = boost::out_edges(boost::vertex(v_sink, G), G); e != eend; ++e)
-    sold += rc_map[*e] - c_map[*e];  
-
-  int revenue = 100 * sold - cost;
+  int sold = assignment.assigned();
+  long revenue = 100L * sold - assignment.cost();
   std::cout << sold << " " << revenue << std::endl;
 }
 
 
 int main() {
+  std::ios_base::sync_with_stdio(false);
+
   int T; std::cin >> T;
-  
+
   while(T--) {
     solve();
   }
@@ -5,12 +5,13 @@
 #include <cmath>
 #include <algorithm>
 #include <vector>
+#include <cstdint>
+#include <cstring>
 
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Delaunay_triangulation_2.h>
 #include <CGAL/Triangulation_vertex_base_with_info_2.h>
 #include <CGAL/Triangulation_face_base_2.h>
-#include <boost/pending/disjoint_sets.hpp>
 
 // Epic kernel is enough, no constructions needed, provided the squared distance
 // fits into a double (!)
@@ -22,8 +23,74 @@ typedef CGAL::Triangulation_face_base_2<K>                     Fb;
 typedef CGAL::Triangulation_data_structure_2<Vb,Fb>            Tds;
 typedef CGAL::Delaunay_triangulation_2<K,Tds>                  Delaunay;
 
-typedef std::tuple<Index,Index,K::FT> Edge;
-typedef std::vector<Edge> EdgeV;
+// all delaunay edges (structure of arrays), sorted by squared length
+struct EdgeList {
+    std::vector<Index> u, v;
+    std::vector<double> length;
+
+    explicit EdgeList(const Delaunay &t) {
+        for(auto e = t.finite_edges_begin(); e != t.finite_edges_end(); ++e) {
+            add(e->first->vertex((e->second + 1) % 3)->info(), e->first->vertex((e->second + 2) % 3)->info(),
+                    t.segment(e).squared_length());
+        }
+        sort();
+    }
+
+    int size() const { return length.size(); }
+
+    // appending breaks the order until sort() is called again
+    void add(Index a, Index b, double squared_length) {
+        u.push_back(a); v.push_back(b); length.push_back(squared_length);
+    }
+
+    // LSD radix sort with 16 bit digits, the bit patterns of non-negative doubles
+    // are ordered like the doubles themselves
+    void sort() {
+        const int m = size();
+        std::vector<uint64_t> key(m), key_tmp(m);
+        std::vector<Index> u_tmp(m), v_tmp(m);
+        for(int i = 0; i < m; ++i) std::memcpy(&key[i], &length[i], sizeof(double));
+
+        std::vector<int> count(1 << 16);
+        for(int shift = 0; shift < 64 && m > 0; shift += 16) {
+            std::fill(count.begin(), count.end(), 0);
+            for(int i = 0; i < m; ++i) count[(key[i] >> shift) & 0xFFFF]++;
+            if(count[(key[0] >> shift) & 0xFFFF] == m) continue; // digit is the same everywhere
+
+            int sum = 0;
+            for(int &c : count) { const int c_old = c; c = sum; sum += c_old; }
+            for(int i = 0; i < m; ++i) {
+                const int pos = count[(key[i] >> shift) & 0xFFFF]++;
+                key_tmp[pos] = key[i]; u_tmp[pos] = u[i]; v_tmp[pos] = v[i];
+            }
+            key.swap(key_tmp); u.swap(u_tmp); v.swap(v_tmp);
+        }
+        for(int i = 0; i < m; ++i) std::memcpy(&length[i], &key[i], sizeof(double));
+    }
+};
+
+// union find that also counts the tents of every component (weight)
+struct Components {
+    std::vector<Index> parent;
+    std::vector<int> weight;
+
+    explicit Components(const std::vector<int> &weights) : parent(weights.size()), weight(weights) {
+        for(std::size_t i = 0; i < parent.size(); ++i) parent[i] = i;
+    }
+
+    Index find(Index x) {
+        while(parent[x] != x) x = parent[x] = parent[parent[x]];
+        return x;
+    }
+
+    // a, b are two different roots, returns the root of the merged component
+    Index link(Index a, Index b) {
+        if(weight[a] < weight[b]) std::swap(a, b);
+        parent[b] = a;
+        weight[a] += weight[b];
+        return a;
+    }
+};
 
 int max_num_fam(std::vector<int> &comp_of_size, int k) {
     // vector is size == k+1
@@ -70,47 +137,28 @@ void testcase() {
     }
     Delaunay t;
     t.insert(points.begin(), points.end());
-    EdgeV edges;
-    edges.reserve(3*n); // there can be no more in a planar graph
-    for (auto e = t.finite_edges_begin(); e != t.finite_edges_end(); ++e) {
-        Index i1 = e->first->vertex((e->second+1)%3)->info();
-        Index i2 = e->first->vertex((e->second+2)%3)->info();
-        // ensure smaller index comes first
-        if (i1 > i2) std::swap(i1, i2);
-        edges.emplace_back(i1, i2, t.segment(e).squared_length());
-    }
-    std::sort(edges.begin(), edges.end(),
-            [](const Edge& e1, const Edge& e2) -> bool {
-            return std::get<2>(e1) < std::get<2>(e2);
-                });
-
+    const EdgeList edges(t);
 
     // for testcases 1-2: just look at smallest distance, bc otherwise not enough tents
-    // std::cout << long(std::get<2>(edges[0])) << " ";
+    // std::cout << long(edges.length[0]) << " ";
 
 
-    boost::disjoint_sets_with_storage<> uf(n);
-    std::vector<Index> num_tents(n, 1);
-    Index n_components = n;
+    Components uf(std::vector<int>(n, 1));
     std::vector<int> comp_of_size(k + 1, 0);
     comp_of_size[1] = n;
     double last_dist = 0;
-    for (EdgeV::const_iterator e = edges.begin(); e != edges.end(); ++e) {
+    for (int i = 0; i < edges.size(); ++i) {
         // determine components of endpoints
-        Index c1 = uf.find_set(std::get<0>(*e));
-        Index c2 = uf.find_set(std::get<1>(*e));
-        last_dist = std::get<2>(*e);
+        Index c1 = uf.find(edges.u[i]);
+        Index c2 = uf.find(edges.v[i]);
+        last_dist = edges.length[i];
         if (c1 != c2) {
-            Index n1 = num_tents[c1];
-            Index n2 = num_tents[c2];
-            uf.link(c1, c2);
-            Index c3 = uf.find_set(std::get<1>(*e));
-            // set unused indices to zero
-            num_tents[c1] = num_tents[c2] = 0;
-            // cap it at k
-            num_tents[c3] = std::min(n1 + n2, k);
+            // component sizes are capped at k
+            int n1 = std::min<int>(uf.weight[c1], k);
+            int n2 = std::min<int>(uf.weight[c2], k);
+            Index c3 = uf.link(c1, c2);
             comp_of_size[n1]--; comp_of_size[n2]--;
-            comp_of_size[num_tents[c3]]++;
+            comp_of_size[std::min<int>(uf.weight[c3], k)]++;
             if (max_num_fam(comp_of_size, k) < f0) break;
         }
     }
@@ -119,31 +167,21 @@ void testcase() {
 
 
     // repeat process with adding edges < s0, then find max num families
-    boost::disjoint_sets_with_storage<> uf_s0(n);
-    num_tents = std::vector<Index>(n, 1);
+    Components uf_s0(std::vector<int>(n, 1));
     comp_of_size = std::vector<int>(k + 1, 0);
     comp_of_size[1] = n;
 
-    n_components = n;
-    for (EdgeV::const_iterator e = edges.begin(); e != edges.end(); ++e) {
+    Index n_components = n;
+    for (int i = 0; i < edges.size() && edges.length[i] < s0; ++i) {
         // determine components of endpoints
-        Index c1 = uf_s0.find_set(std::get<0>(*e));
-        Index c2 = uf_s0.find_set(std::get<1>(*e));
-        double dist = std::get<2>(*e);
-        if(dist >= s0) {
-            break;
-        }
+        Index c1 = uf_s0.find(edges.u[i]);
+        Index c2 = uf_s0.find(edges.v[i]);
         if (c1 != c2) {
-            Index n1 = num_tents[c1];
-            Index n2 = num_tents[c2];
-            uf_s0.link(c1, c2);
-            Index c3 = uf_s0.find_set(std::get<1>(*e));
-            // set unused indices to zero
-            num_tents[c1] = num_tents[c2] = 0;
-            // cap component size at k
-            num_tents[c3] = std::min(n1 + n2, k);
+            int n1 = std::min<int>(uf_s0.weight[c1], k);
+            int n2 = std::min<int>(uf_s0.weight[c2], k);
+            Index c3 = uf_s0.link(c1, c2);
             comp_of_size[n1]--; comp_of_size[n2]--;
-            comp_of_size[num_tents[c3]]++;
+            comp_of_size[std::min<int>(uf_s0.weight[c3], k)]++;
             if (--n_components == 1) break;
         }
     }
@@ -1,16 +1,13 @@
 #include <iostream>
 #include <vector>
-#include <stack>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Delaunay_triangulation_2.h>
 #include <CGAL/Triangulation_vertex_base_with_info_2.h>
 #include <CGAL/Triangulation_face_base_2.h>
-#include <boost/pending/disjoint_sets.hpp>
-#include <vector>
-#include <tuple>
-#include <algorithm>
-#include <iostream>
 
 // Epic kernel is enough, no constructions needed, provided the squared distance
 // fits into a double (!)
@@ -23,70 +20,94 @@ typedef CGAL::Triangulation_data_structure_2<Vb,Fb>            Tds;
 typedef CGAL::Delaunay_triangulation_2<K,Tds>                  Delaunay;
 typedef Delaunay::Vertex_handle Vertex_handle;
 
+typedef std::pair<K::Point_2,Index> IPoint;
 
-typedef std::tuple<Index,Index,K::FT> Edge;
-typedef std::vector<Edge> EdgeV;
+// Delaunay edges as structure of arrays (endpoints u, v and squared length), sorted ascendingly by length.
+// Two planets are connected within distance r iff they are connected by Delaunay edges of length <= r
+struct EdgeList {
+  std::vector<Index> u, v;
+  std::vector<double> length;
 
-typedef std::pair<K::Point_2,Index> IPoint;
+  explicit EdgeList(const Delaunay &t) {
+    for(auto e = t.finite_edges_begin(); e != t.finite_edges_end(); ++e) {
+      add(e->first->vertex((e->second + 1) % 3)->info(), e->first->vertex((e->second + 2) % 3)->info(),
+          t.segment(e).squared_length());
+    }
+    sort();
+  }
 
-std::ostream& operator<<(std::ostream& o, const Edge& e) {
-  return o << std::get<0>(e) << " " << std::get<1>(e) << " " << std::get<2>(e);
-}
+  int size() const { return length.size(); }
+
+  // Appends an edge, the list has to be sorted again afterwards
+  void add(Index a, Index b, double squared_length) {
+    u.push_back(a); v.push_back(b); length.push_back(squared_length);
+  }
+
+  // LSD radix sort on 16 bit digits. The bits of a non-negative double compare like the double itself
+  void sort() {
+    const int m = size();
+    std::vector<uint64_t> key(m), key_tmp(m);
+    std::vector<Index> u_tmp(m), v_tmp(m);
+    for(int i = 0; i < m; ++i) std::memcpy(&key[i], &length[i], sizeof(double));
+
+    std::vector<int> count(1 << 16);
+    for(int shift = 0; shift < 64 && m > 0; shift += 16) {
+      std::fill(count.begin(), count.end(), 0);
+      for(int i = 0; i < m; ++i) count[(key[i] >> shift) & 0xFFFF]++;
+      if(count[(key[0] >> shift) & 0xFFFF] == m) continue; // All keys share this digit
+
+      int sum = 0;
+      for(int &c : count) { const int c_old = c; c = sum; sum += c_old; }
+      for(int i = 0; i < m; ++i) {
+        const int pos = count[(key[i] >> shift) & 0xFFFF]++;
+        key_tmp[pos] = key[i]; u_tmp[pos] = u[i]; v_tmp[pos] = v[i];
+      }
+      key.swap(key_tmp); u.swap(u_tmp); v.swap(v_tmp);
+    }
+    for(int i = 0; i < m; ++i) std::memcpy(&length[i], &key[i], sizeof(double));
+  }
+};
+
+// Union-Find (union by size, path halving) that keeps the number of planets of every component (weight)
+struct Components {
+  std::vector<Index> parent;
+  std::vector<int> weight;
+
+  explicit Components(const std::vector<int> &weights) : parent(weights.size()), weight(weights) {
+    for(std::size_t i = 0; i < parent.size(); ++i) parent[i] = i;
+  }
+
+  Index find(Index x) {
+    while(parent[x] != x) x = parent[x] = parent[parent[x]];
+    return x;
+  }
+
+  // Merges the components with roots a != b, returns the new root
+  Index link(Index a, Index b) {
+    if(weight[a] < weight[b]) std::swap(a, b);
+    parent[b] = a;
+    weight[a] += weight[b];
+    return a;
+  }
+};
 
 const bool DEBUG = false;
 
-bool possible(const std::vector<IPoint> planets, int k, int n, K::FT r_squared) {
+bool possible(const std::vector<IPoint> &planets, int k, int n, K::FT r_squared) {
   // Triangulate the points starting from k
   Delaunay t;
   t.insert(planets.begin() + k, planets.end());
-  
-  // Extract edges
-  EdgeV edges;
-  edges.reserve(3*n); // there can be no more in a planar graph
-  for (auto e = t.finite_edges_begin(); e != t.finite_edges_end(); ++e) {
-    Index i1 = e->first->vertex((e->second+1)%3)->info();
-    Index i2 = e->first->vertex((e->second+2)%3)->info();
-    // ensure smaller index comes first
-    if (i1 > i2) std::swap(i1, i2);
-    edges.emplace_back(i1, i2, t.segment(e).squared_length());
-  }
-  
-  // Sort edges
-  std::sort(edges.begin(), edges.end(),
-      [](const Edge& e1, const Edge& e2) -> bool {
-        return std::get<2>(e1) < std::get<2>(e2);
-            });
-  
-  // Setup and initialize Union-Find Data Structure
-  boost::disjoint_sets_with_storage<> uf(n);
-  std::vector<int> component_sizes(n, 1);
-  for (EdgeV::const_iterator e = edges.begin(); e != edges.end(); ++e) {
-    Index v1 = std::get<0>(*e);
-    Index v2 = std::get<1>(*e);
-    
-    // Determine Components of Endpoints
-    Index c1 = uf.find_set(v1);
-    Index c2 = uf.find_set(v2);
-    K::FT dist = std::get<2>(*e);
-    
-    if (
-      c1 != c2 && 
-      dist <= r_squared
-    ) {
-      int size1 = component_sizes[c1];
-      int size2 = component_sizes[c2];
-      uf.link(c1, c2);
-      
-      Index c3 = uf.find_set(v1);
-      component_sizes[c3] = size1 + size2;
+  const EdgeList edges(t);
+
+  // Merge the components along the edges of length <= r and keep track of the biggest one
+  Components components(std::vector<int>(n, 1));
+  int max_size = 1;
+  for(int i = 0; i < edges.size() && edges.length[i] <= r_squared; ++i) {
+    const Index c1 = components.find(edges.u[i]), c2 = components.find(edges.v[i]);
+    if(c1 != c2) {
+      max_size = std::max(max_size, components.weight[components.link(c1, c2)]);
     }
   }
-  
-  // Find biggest component
-  int max_size = 0;
-  for(int i = 0; i < n; ++i) {
-    max_size = std::max(max_size, component_sizes[i]);
-  }
 
   return max_size >= k;
 }
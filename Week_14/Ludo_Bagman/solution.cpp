@@ -1,7 +1,8 @@
 #include <iostream>
+#include <vector>
+#include <utility>
 
 #include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/cycle_canceling.hpp>
 #include <boost/graph/push_relabel_max_flow.hpp>
 #include <boost/graph/successive_shortest_path_nonnegative_weights.hpp>
 #include <boost/graph/find_flow_cost.hpp>
@@ -18,15 +19,13 @@ typedef boost::graph_traits<graph>::vertex_descriptor           vertex_desc;
 typedef boost::graph_traits<graph>::edge_descriptor             edge_desc;
 typedef boost::graph_traits<graph>::out_edge_iterator           out_edge_it; // Iterator
 
-const int MAX_L = 250;
-
 // Custom edge adder class
 class edge_adder {
  graph &G;
 
  public:
   explicit edge_adder(graph &G) : G(G) {}
-  void add_edge(int from, int to, long capacity, long cost) {
+  edge_desc add_edge(int from, int to, long capacity, long cost) {
     auto c_map = boost::get(boost::edge_capacity, G);
     auto r_map = boost::get(boost::edge_reverse, G);
     auto w_map = boost::get(boost::edge_weight, G); // new!
@@ -38,61 +37,121 @@ class edge_adder {
     r_map[rev_e] = e;
     w_map[e] = cost;   // new assign cost
     w_map[rev_e] = -cost;   // new negative cost
+    return e;
   }
 };
 
+// Flow with lower and upper bounds on the edges and supplies (or demands) on the nodes.
+// All lower bounds are sent right away, which leaves every edge with capacity upper - lower and some imbalance at its
+// endpoints. A super source covers the positive imbalances and a super sink takes the negative ones: a valid flow
+// exists exactly if the max flow between them saturates all of these edges
+class BoundedFlow {
+  int n;
+  graph G;
+  edge_adder adder;
+  std::vector<long> imbalance;
+  std::vector<std::pair<edge_desc, long>> edges; // Reduced edge and lower bound of every added edge
+  long lower_cost = 0, total_cost = 0;
+
+  public:
+    static const long INF = 1L << 40;
+
+    explicit BoundedFlow(int n) : n(n), G(n + 2), adder(G), imbalance(n, 0) {}
+
+    // Adds an edge with lower <= flow <= upper and the given cost per unit. Returns its index for flow()
+    int add_edge(int from, int to, long lower, long upper, long cost = 0) {
+      imbalance[from] -= lower;
+      imbalance[to] += lower;
+      lower_cost += lower * cost;
+      edges.emplace_back(adder.add_edge(from, to, upper - lower, cost), lower);
+      return edges.size() - 1;
+    }
+
+    // The node sends out this much more than it receives (receives more if supply is negative)
+    void add_supply(int node, long supply) {
+      imbalance[node] += supply;
+    }
+
+    // Searches a valid flow, of minimum cost if min_cost is set (needs non-negative costs). Returns if one exists
+    bool solve(bool min_cost = false) {
+      const vertex_desc v_source = n, v_sink = n + 1;
+
+      long required = 0;
+      for(int i = 0; i < n; ++i) {
+        if(imbalance[i] > 0) {
+          adder.add_edge(v_source, i, imbalance[i], 0);
+          required += imbalance[i];
+        } else if(imbalance[i] < 0) {
+          adder.add_edge(i, v_sink, -imbalance[i], 0);
+        }
+      }
+
+      long flow = 0;
+      if(min_cost) {
+        boost::successive_shortest_path_nonnegative_weights(G, v_source, v_sink);
+        total_cost = lower_cost + boost::find_flow_cost(G);
+
+        auto c_map = boost::get(boost::edge_capacity, G);
+        auto rc_map = boost::get(boost::edge_residual_capacity, G);
+        out_edge_it e, eend;
+        for(boost::tie(e, eend) = boost::out_edges(v_source, G); e != eend; ++e) flow += c_map[*e] - rc_map[*e];
+      } else {
+        flow = boost::push_relabel_max_flow(G, v_source, v_sink);
+      }
+
+      return flow == required;
+    }
+
+    // Flow on the edge with the given index, after solve() found a valid flow
+    long flow(int edge) {
+      auto c_map = boost::get(boost::edge_capacity, G);
+      auto rc_map = boost::get(boost::edge_residual_capacity, G);
+      const edge_desc e = edges[edge].first;
+      return edges[edge].second + c_map[e] - rc_map[e];
+    }
+
+    // Cost of the flow, after solve(true) found a valid flow
+    long cost() const {
+      return total_cost;
+    }
+};
+
 void solve() {
-  // std::cout << "==================================================================" << std::endl;
   // ===== READ INPUT =====
   int e, w, m, d, p, l; std::cin >> e >> w >> m >> d >> p >> l;
 
-  graph G(e + w);
-  edge_adder adder(G);
-  
-  // Setup source and sink
-  const vertex_desc v_source = boost::add_vertex(G);
-  const vertex_desc pseudo_source = boost::add_vertex(G);
-  const vertex_desc v_target = boost::add_vertex(G);
-  const vertex_desc pseudo_target = boost::add_vertex(G);
+  // East teams 0..e-1, west teams e..e+w-1. Exactly p matches flow from the source to the target
+  BoundedFlow schedule(e + w + 2);
+  const int v_source = e + w;
+  const int v_target = e + w + 1;
+  schedule.add_supply(v_source, p);
+  schedule.add_supply(v_target, -p);
   
-  adder.add_edge(v_source, pseudo_source, p - (l * e), 0);
-  adder.add_edge(pseudo_target, v_target, p - (l * w), 0);
-  
-  // Create source and sink connections
+  // Every team plays at least l non-difficult matches
   for(int i = 0; i < e; ++i) {
-    adder.add_edge(v_source, i, l, 0);
-    adder.add_edge(pseudo_source, i, MAX_L, 0);
+    schedule.add_edge(v_source, i, l, BoundedFlow::INF);
   }
   for(int i = 0; i < w; ++i) {
-    adder.add_edge(e + i, v_target, l, 0);
-    adder.add_edge(e + i, pseudo_target, MAX_L, 0);
+    schedule.add_edge(e + i, v_target, l, BoundedFlow::INF);
   }
   
   // Read matches
   for(int i = 0; i < m; ++i) {
     int u, v, r; std::cin >> u >> v >> r;
-    adder.add_edge(u, e + v, 1, r);
+    schedule.add_edge(u, e + v, 0, 1, r);
   }
   
-  // Read dangerous matches (ignore for now)
+  // Dangerous matches count towards p, but don't help any team
   for(int i = 0; i < d; ++i) {
     int u, v, r; std::cin >> u >> v >> r;
-    adder.add_edge(pseudo_source, pseudo_target, 1 , r);
+    schedule.add_edge(v_source, v_target, 0, 1, r);
   }
   
-  // ===== SOLVE =====
-  int flow = boost::push_relabel_max_flow(G, v_source, v_target);
-  boost::successive_shortest_path_nonnegative_weights(G, v_source, v_target);
-  int cost = boost::find_flow_cost(G);
-  
-  // ===== OUTPUT =====
-  // std::cout << flow << " " << cost << std::endl;
-  if(flow == p) {
-    std::cout << cost << std::endl;
-  } else if (flow < p) {
-    std::cout << "No schedule!" << std::endl;
+  // ===== SOLVE & OUTPUT =====
+  if(schedule.solve(true)) {
+    std::cout << schedule.cost() << std::endl;
   } else {
-    std::cout << "ERROR: flow (" << flow << "( is higher than p (" << p << ")" << std::endl;
+    std::cout << "No schedule!" << std::endl;
   }
 }
 
@@ -101,4 +160,4 @@ int main() {
   
   int n_tests; std::cin >> n_tests;
   while(n_tests--) { solve(); }
-}
\ No newline at end of file
+}